@@ -3425,6 +3425,27 @@ static inline bool k_work_is_pending(const struct k_work *work);
 int k_work_submit_to_queue(struct k_work_q *queue,
 			   struct k_work *work);
 
+/** @brief Submit several work items to a queue at once.
+ *
+ * Like k_work_submit_to_queue() called for each item, but the lock of
+ * the work module is taken once and the queue thread is woken up once,
+ * after all the items are queued.  Items already queued are left where
+ * they are, and a running item goes to the queue running it.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.
+ *
+ * @param works array of pointers to the work items.
+ *
+ * @param count number of work items in @p works.
+ *
+ * @return the number of items queued by this call, or if none was, the
+ * error of the last rejected item as for k_work_submit_to_queue().
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work **works, size_t count);
+
 /** @brief Submit a work item to the system queue.
  *
  * @funcprops \isr_ok
@@ -3600,6 +3621,64 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+/** @brief Start a pool of work queues.
+ *
+ * This starts @p num_queues work queues sharing their work items: work
+ * submitted to the pool goes to the queue of the submitting worker, or of
+ * the current CPU, and a worker without pending work takes the oldest item
+ * of another queue of the pool before going to sleep.  The items, flushes
+ * and cancellations keep the semantics of a single work queue: an item
+ * never runs on two workers at once, and is always resubmitted to the
+ * queue running it.
+ *
+ * The work queues are ordinary work queues, which can also be used with
+ * the other work queue APIs.  A draining or plugged queue does not take
+ * items from the others.
+ *
+ * @note Requires CONFIG_WORK_POOL.
+ *
+ * @param pool pointer to the pool structure.
+ *
+ * @param queues array of @p num_queues work queue structures, in zeroed
+ *        memory or initialized with @ref k_work_queue_init.
+ *
+ * @param num_queues number of work queues, and of worker threads.
+ *
+ * @param stacks array of @p num_queues stacks, as defined by
+ *        K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param stack_size size of each stack, as passed to
+ *        K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param prio initial priority of the worker threads.
+ *
+ * @param cfg optional additional configuration parameters, applied to
+ *        every work queue.  Pass @c NULL if not required.
+ */
+void k_work_pool_start(struct k_work_pool *pool, struct k_work_q *queues,
+		       size_t num_queues, k_thread_stack_t *stacks,
+		       size_t stack_size, int prio,
+		       const struct k_work_queue_config *cfg);
+
+/** @brief Submit a work item to a pool of work queues.
+ *
+ * The item goes to the queue of the calling worker thread of the pool, or
+ * else to the one of the current CPU, and an idle worker is woken up when
+ * that queue is busy.  Like k_work_submit_to_queue(), a queued item is left
+ * where it is and a running item is resubmitted to the queue running it.
+ *
+ * @note Requires CONFIG_WORK_POOL.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return the result of k_work_submit_to_queue() for the chosen queue.
+ */
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work);
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3913,6 +3992,8 @@ enum {
 	/* Static work queue flags */
 	K_WORK_QUEUE_NO_YIELD_BIT = 8,
 	K_WORK_QUEUE_NO_YIELD = BIT(K_WORK_QUEUE_NO_YIELD_BIT),
+	K_WORK_QUEUE_BATCH_BIT = 9,
+	K_WORK_QUEUE_BATCH = BIT(K_WORK_QUEUE_BATCH_BIT),
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -4099,6 +4180,20 @@ struct k_work_queue_config {
 	 */
 	bool no_yield;
 
+	/** Control whether the work queue thread should run the pending
+	 * items in batch.
+	 *
+	 * By default the work queue thread takes the lock of the work
+	 * module once to take an item and once to complete it.  Set this
+	 * to @c true to complete an item and take the next one with the
+	 * same lock, and not yield between the items until no more are
+	 * pending, which favors the throughput of bursts of items over the
+	 * latency of other threads.  The completion of a flush or of a
+	 * cancellation of an item is then signaled right before the next
+	 * item starts, or the thread goes idle.
+	 */
+	bool batch;
+
 	/** Control whether the work queue thread should be marked as
 	 * essential thread.
 	 */
@@ -4125,6 +4220,20 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORK_POOL
+	/* Pool the queue is a worker of, if any. */
+	struct k_work_pool *pool;
+#endif /* CONFIG_WORK_POOL */
+};
+
+/** @brief A pool of work queues sharing their work items. */
+struct k_work_pool {
+	/* The work queues of the worker threads. */
+	struct k_work_q *queues;
+
+	/* Number of work queues. */
+	size_t num_queues;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -5160,6 +5269,15 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/* Free blocks of a memory slab kept by one CPU */
+struct k_mem_slab_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	char *blocks[CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE];
+};
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5167,6 +5285,14 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	/* Threads short of blocks, the caches are bypassed meanwhile */
+	atomic_t cache_bypass;
+
+	/* The cached blocks are counted as used in info */
+	struct k_mem_slab_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5184,6 +5310,22 @@ struct k_mem_slab {
 	.info = {_slab_num_blocks, _slab_block_size, 0}               \
 	}
 
+/* Number of blocks allocated by the users of a memory slab */
+static inline uint32_t z_mem_slab_num_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	/* The caches may be refilled or flushed while being counted */
+	return (slab->info.num_used > cached) ? (slab->info.num_used - cached) : 0U;
+#else
+	return slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+}
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -5320,7 +5462,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_used;
+	return z_mem_slab_num_used(slab);
 }
 
 /**
@@ -5355,7 +5497,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - z_mem_slab_num_used(slab);
 }
 
 /**
@@ -5394,10 +5536,27 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+/* Cached block sizes, 32 bytes to 256 bytes */
+#define Z_HEAP_CACHE_CLASSES 4
+
+/* Free blocks of a heap kept by one CPU */
+struct k_heap_cache {
+	struct k_spinlock lock;
+	uint8_t count[Z_HEAP_CACHE_CLASSES];
+	void *blocks[Z_HEAP_CACHE_CLASSES][CONFIG_HEAP_PER_CPU_CACHE_SIZE];
+};
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	/* Threads short of memory, the caches are bypassed meanwhile */
+	atomic_t cache_bypass;
+	struct k_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
 };
 
 /**
@@ -5973,6 +6132,83 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A set of poll events registered once with their objects, for a thread
+ * repeatedly waiting on the same events.  The events signaled by their
+ * objects are queued on the set, so that waiting on the set only goes
+ * through the events that are ready instead of all the events.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/* Events signaled and not returned yet */
+	sys_dlist_t ready;
+
+	/* Events returned by the last wait, registered again by the next */
+	sys_dlist_t rearm;
+
+	struct k_poll_event *events;
+	int num_events;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * Registers the events with their objects.  The events must stay valid,
+ * and must not be passed to k_poll(), until k_poll_set_clear() is called.
+ *
+ * @note Only available from kernel mode.
+ *
+ * @param set The poll set to initialize.
+ * @param events An array of events initialized with k_poll_event_init().
+ * @param num_events The number of events in the array.
+ */
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events);
+
+/**
+ * @brief Wait for events of a poll set to occur.
+ *
+ * Returns the events of the set which occurred since they were last
+ * returned, with their state field set as with k_poll().  The events
+ * returned by a call are registered again with their objects by the next
+ * call, so their state must not be relied on after that.
+ *
+ * As with k_poll(), the threads pending on an object have precedence over
+ * the poll set, and any thread polling the object with k_poll() is
+ * notified before the poll set.
+ *
+ * @note Only available from kernel mode, by one thread at a time.
+ *
+ * @param set The poll set.
+ * @param ready Buffer for pointers to the events which occurred.
+ * @param max_ready Size of the buffer.  The events which do not fit are
+ *                  returned by the next call.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events written to @a ready, at least 1.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout);
+
+/**
+ * @brief Remove the events of a poll set from their objects.
+ *
+ * After this call the events may be reused, and the set initialized again.
+ * No thread may be waiting on the set.
+ *
+ * @param set The poll set.
+ */
+void k_poll_set_clear(struct k_poll_set *set);
+
 /** @} */
 
 /**
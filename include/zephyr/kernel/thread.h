@@ -114,6 +114,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* CPU index of the run queue holding the thread */
+	uint8_t runq_cpu;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -124,6 +124,22 @@ struct _priq_mq {
 	unsigned long bitmask[PRIQ_BITMAP_SIZE];
 };
 
+/* Multi-queue structure with the lists sorted by deadline, and with a
+ * bitmap of the non-empty priorities for each CPU when threads have CPU
+ * masks, so that both EDF and affinity keep O(1) picks of the best
+ * priority.
+ */
+struct _priq_bm {
+	sys_dlist_t queues[K_NUM_THREAD_PRIO];
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* Number of threads of each priority allowed on each CPU */
+	uint16_t cpu_count[CONFIG_MP_MAX_NUM_CPUS][K_NUM_THREAD_PRIO];
+	unsigned long bitmask[CONFIG_MP_MAX_NUM_CPUS][PRIQ_BITMAP_SIZE];
+#else
+	unsigned long bitmask[PRIQ_BITMAP_SIZE];
+#endif /* CONFIG_SCHED_CPU_MASK */
+};
+
 struct _ready_q {
 #ifndef CONFIG_SMP
 	/* always contains next thread to run: cannot be NULL */
@@ -136,6 +152,13 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bm runq;
+#endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Number of threads in runq */
+	uint32_t count;
 #endif
 };
 
@@ -154,7 +177,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -210,7 +233,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -302,6 +325,10 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* CPU owning the timeout */
+	uint8_t cpu;
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
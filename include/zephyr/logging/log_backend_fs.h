@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LOG_BACKEND_FS_H_
+#define ZEPHYR_LOG_BACKEND_FS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Write the buffered log output to the log file
+ *
+ * @details With CONFIG_LOG_BACKEND_FS_BUFFERED, the formatted log output is kept in a RAM
+ *          buffer until it fills up or CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS have elapsed.
+ *          This function writes it to the log file, and syncs the file, at once, for example
+ *          before a controlled reset. It must not be called from an interrupt.
+ *
+ * @retval 0 if the buffered output has been written, or there was none.
+ * @retval -ENOSPC if no room could be made for it in the file system, it is dropped then.
+ */
+#if defined(CONFIG_LOG_BACKEND_FS_BUFFERED)
+int log_backend_fs_flush(void);
+#else
+static inline int log_backend_fs_flush(void)
+{
+	return 0;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LOG_BACKEND_FS_H_ */
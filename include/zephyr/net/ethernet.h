@@ -204,6 +204,13 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. Packets with a non zero
+	 * net_pkt_gso_size() are given to the driver as is, the driver
+	 * cuts them into segments of that size and computes the IP and TCP
+	 * checksums of each segment.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
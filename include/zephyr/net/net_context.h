@@ -288,6 +288,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Epoll interest set entries watching this socket */
+	sys_slist_t epoll_items;
+#endif
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
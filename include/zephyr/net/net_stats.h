@@ -167,6 +167,17 @@ struct net_stats_tcp {
 	net_stats_t connrst;
 };
 
+/**
+ * @brief Generic receive offload (GRO) statistics
+ */
+struct net_stats_gro {
+	/** Number of TCP segments merged into a previous segment. */
+	net_stats_t merged;
+
+	/** Number of merged packets passed to the IP layer. */
+	net_stats_t flushed;
+};
+
 /**
  * @brief UDP statistics
  */
@@ -360,6 +371,11 @@ struct net_stats {
 	struct net_stats_udp udp;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+	/** Generic receive offload statistics */
+	struct net_stats_gro gro;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_IPV6_ND)
 	/** IPv6 neighbor discovery statistics */
 	struct net_stats_ipv6_nd ipv6_nd;
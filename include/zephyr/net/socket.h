@@ -31,9 +31,11 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket_select.h>
 #include <zephyr/net/socket_poll.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/net/dns_resolve.h>
+#include <errno.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -76,6 +78,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Override to non-blocking after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -496,6 +500,27 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * Sends up to ``vlen`` messages with a single system call, holding the
+ * socket lock for the whole batch. The number of bytes sent for each
+ * message is stored in its ``msg_len`` field.
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for the semantics.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -526,6 +551,29 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * Receives up to ``vlen`` messages with a single system call, holding the
+ * socket lock for the whole batch. The number of bytes received for each
+ * message is stored in its ``msg_len`` field. With ``ZSOCK_MSG_WAITFORONE``
+ * only the first message is waited for. Unlike Linux there is no timeout
+ * argument, ``SO_RCVTIMEO`` applies to each message instead.
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for the semantics.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -544,6 +592,71 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Data lent by zsock_recv_zc()
+ *
+ * The data starts @p offset bytes into the first fragment and continues
+ * in the following fragments of the chain, for @p len bytes in total.
+ */
+struct zsock_recv_zc_buf {
+	/** First fragment holding received data */
+	struct net_buf *frags;
+	/** Offset of the data in the first fragment */
+	size_t offset;
+	/** Total length of the data */
+	size_t len;
+	/** @cond INTERNAL_HIDDEN */
+	/* Packet owning the fragments */
+	void *pkt;
+	/* Referenced context of a stream socket, its receive window is opened
+	 * on release.
+	 */
+	void *ctx;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * @rst
+ * Dequeue the next received packet of a native socket, a datagram for
+ * ``SOCK_DGRAM`` sockets or the next received segment for ``SOCK_STREAM``
+ * sockets, and lend its network buffers to the caller. The buffers stay
+ * owned by the socket layer and must be given back with
+ * zsock_recv_zc_release(). For ``SOCK_STREAM`` sockets, the receive window
+ * is only opened when the data is released. Only ``ZSOCK_MSG_DONTWAIT`` is
+ * supported in ``flags``.
+ * This function cannot be called from user mode threads, and is only
+ * available if :kconfig:option:`CONFIG_NET_SOCKETS_RECV_ZEROCOPY` is
+ * defined.
+ * @endrst
+ *
+ * @param sock Socket to receive from.
+ * @param zc Filled with the lent data on success.
+ * @param flags Receive flags.
+ * @param src_addr Source address of the data, can be NULL.
+ * @param addrlen Length of @p src_addr, value-result argument.
+ *
+ * @return Number of bytes lent, 0 on EOF for SOCK_STREAM sockets, or -1
+ *         with errno set.
+ */
+ssize_t zsock_recv_zc(int sock, struct zsock_recv_zc_buf *zc, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Give back data lent by zsock_recv_zc()
+ *
+ * The data is freed, and the receive window of the socket it was received
+ * from opened, even if the socket was closed, and its descriptor reused, in
+ * between.
+ *
+ * @param zc Data filled by zsock_recv_zc().
+ */
+void zsock_recv_zc_release(struct zsock_recv_zc_buf *zc);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -943,6 +1056,13 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -956,6 +1076,20 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+struct timespec;
+
+/** POSIX wrapper for @ref zsock_recvmmsg, a timeout is not supported */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags, struct timespec *timeout)
+{
+	if (timeout != NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1062,6 +1196,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1211,6 +1347,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, passed as a name string (e.g. "cubic") */
+#define TCP_CONGESTION 5
 
 /** @} */
 
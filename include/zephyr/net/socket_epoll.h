@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file socket_epoll.h
+ *
+ * @brief Scalable I/O event notification for sockets.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Events for zsock_epoll_ctl() and zsock_epoll_wait()
+ * @{
+ */
+/* The ZSOCK_EPOLL* event values are the same as the ZSOCK_POLL* ones */
+/** Data is available to be read */
+#define ZSOCK_EPOLLIN 0x1
+/** Data can be written without blocking */
+#define ZSOCK_EPOLLOUT 0x4
+/** Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x8
+/** Hang up, always reported */
+#define ZSOCK_EPOLLHUP 0x10
+/** Report the descriptor only once, until it is re-armed with
+ *  ZSOCK_EPOLL_CTL_MOD
+ */
+#define ZSOCK_EPOLLONESHOT (1U << 30)
+/** Edge triggered, report the descriptor only when its state changes */
+#define ZSOCK_EPOLLET (1U << 31)
+/** @} */
+
+/**
+ * @name Operations for zsock_epoll_ctl()
+ * @{
+ */
+/** Add a descriptor to the interest set */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a descriptor from the interest set */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events of a descriptor in the interest set */
+#define ZSOCK_EPOLL_CTL_MOD 3
+/** @} */
+
+/** User data returned with an event */
+typedef union zsock_epoll_data {
+	void *ptr;     /**< Pointer */
+	int fd;        /**< File descriptor */
+	uint32_t u32;  /**< 32 bit value */
+	uint64_t u64;  /**< 64 bit value */
+} zsock_epoll_data_t;
+
+/** Event registered with zsock_epoll_ctl() or returned by zsock_epoll_wait() */
+struct zsock_epoll_event {
+	uint32_t events;          /**< Requested or returned events */
+	zsock_epoll_data_t data;  /**< User data */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * Create an interest set of file descriptors which can be waited for with
+ * zsock_epoll_wait(). Unlike zsock_poll(), the descriptors are registered
+ * once, and native sockets report their readiness to the instance when it
+ * changes, so the wait does not scan every registered descriptor.
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/epoll_create1.2.html>`__
+ * for the semantics. The instance is closed with zsock_close().
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param flags Must be 0.
+ *
+ * @return File descriptor of the instance, or -1 with errno set.
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Change the interest set of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for the semantics. A socket is removed from all the interest sets
+ * when it is closed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd Epoll instance.
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_DEL or ZSOCK_EPOLL_CTL_MOD.
+ * @param fd File descriptor to add, remove or modify.
+ * @param event Requested events and user data, ignored for
+ *        ZSOCK_EPOLL_CTL_DEL.
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux man page
+ * <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for the semantics.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd Epoll instance.
+ * @param events Buffer for the returned events.
+ * @param maxevents Number of entries in the events buffer.
+ * @param timeout Timeout in milliseconds, -1 to wait forever.
+ *
+ * @return Number of returned events, 0 on timeout, or -1 with errno set.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
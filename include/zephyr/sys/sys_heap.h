@@ -65,6 +65,14 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	/* Cycles spent in the alloc and free functions */
+	uint64_t total_alloc_cycles;
+	uint64_t total_free_cycles;
+	/* Latency percentiles of the alloc function, in cycles */
+	uint32_t alloc_cycles_p50;
+	uint32_t alloc_cycles_p90;
+	uint32_t alloc_cycles_p99;
+	uint32_t alloc_cycles_max;
 };
 
 /**
@@ -229,7 +237,8 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations and the cycles spent in the callbacks (with percentiles
+ * of the allocation latency), are returned via the @a result struct.
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
@@ -41,6 +41,17 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 			 "Only one CPU allowed in mask when PIN_ONLY");
 #endif /* defined(CONFIG_ASSERT) && defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) */
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* The timeout of the thread follows it to a CPU it may run on */
+	struct _timeout *to = &thread->base.timeout;
+	uint32_t mask = thread->base.cpu_mask & BIT_MASK(arch_num_cpus());
+
+	if ((ret == 0) && (mask != 0U) && !z_is_inactive_timeout(to) &&
+	    ((mask & BIT(to->cpu)) == 0U)) {
+		z_move_timeout(to, __builtin_ctz(mask));
+	}
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 	return ret;
 }
 
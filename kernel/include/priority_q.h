@@ -31,20 +31,26 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 #define _priq_run_best		z_priq_rb_best
  /* Multi Queue Scheduling */
 #elif defined(CONFIG_SCHED_MULTIQ)
-
-#if defined(CONFIG_64BIT)
-#define NBITS 64
-#else
-#define NBITS 32
-#endif /* CONFIG_64BIT */
-
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
+ /* Bitmap Scheduling */
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_add		z_priq_bm_add
+#define _priq_run_remove	z_priq_bm_remove
+#define _priq_run_best		z_priq_bm_best
 #endif
 
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_SCHED_BITMAP)
+#if defined(CONFIG_64BIT)
+#define NBITS 64
+#else
+#define NBITS 32
+#endif /* CONFIG_64BIT */
+#endif /* CONFIG_SCHED_MULTIQ || CONFIG_SCHED_BITMAP */
+
 /* Scalable Wait Queue */
 #if defined(CONFIG_WAITQ_SCALABLE)
 #define _priq_wait_add		z_priq_rb_add
@@ -118,33 +124,40 @@ static ALWAYS_INLINE struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
-static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
+/* Offset from K_HIGHEST_THREAD_PRIO of the best priority set in a
+ * priority bitmap, or -1 if none is set
+ */
+static ALWAYS_INLINE int z_priq_mq_best_prio(const unsigned long *bitmask)
 {
-	struct k_thread *thread = NULL;
-
 	for (int i = 0; i < PRIQ_BITMAP_SIZE; ++i) {
-		if (!pq->bitmask[i]) {
-			continue;
-		}
-
+		if (bitmask[i] != 0UL) {
 #ifdef CONFIG_64BIT
-		sys_dlist_t *l = &pq->queues[i * 64 + u64_count_trailing_zeros(pq->bitmask[i])];
+			return i * 64 + u64_count_trailing_zeros(bitmask[i]);
 #else
-		sys_dlist_t *l = &pq->queues[i * 32 + u32_count_trailing_zeros(pq->bitmask[i])];
-#endif
-		sys_dnode_t *n = sys_dlist_peek_head(l);
-
-		if (n != NULL) {
-			thread = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
-			break;
+			return i * 32 + u32_count_trailing_zeros(bitmask[i]);
+#endif /* CONFIG_64BIT */
 		}
 	}
 
-	return thread;
+	return -1;
 }
 
+static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
+{
+	int offset_prio = z_priq_mq_best_prio(pq->bitmask);
+	sys_dnode_t *n;
+
+	if (offset_prio < 0) {
+		return NULL;
+	}
+
+	n = sys_dlist_peek_head(&pq->queues[offset_prio]);
+
+	return (n != NULL) ? CONTAINER_OF(n, struct k_thread, base.qnode_dlist) : NULL;
+}
 
-#ifdef CONFIG_SCHED_MULTIQ
+
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_SCHED_BITMAP)
 
 struct prio_info {
 	uint8_t offset_prio;
@@ -162,7 +175,9 @@ static ALWAYS_INLINE struct prio_info get_prio_info(int8_t old_prio)
 
 	return ret;
 }
+#endif /* CONFIG_SCHED_MULTIQ || CONFIG_SCHED_BITMAP */
 
+#ifdef CONFIG_SCHED_MULTIQ
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread)
 {
@@ -186,6 +201,107 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 
 
 
+#ifdef CONFIG_SCHED_BITMAP
+
+static ALWAYS_INLINE void z_priq_bm_insert(sys_dlist_t *l,
+					   struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_DEADLINE
+	struct k_thread *t;
+
+	/* Only the threads of the same priority are sorted by deadline,
+	 * the ones with the same deadline stay in FIFO order.
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(l, t, base.qnode_dlist) {
+		if (z_sched_prio_cmp(thread, t) > 0) {
+			sys_dlist_insert(&t->base.qnode_dlist,
+					 &thread->base.qnode_dlist);
+			return;
+		}
+	}
+#endif /* CONFIG_SCHED_DEADLINE */
+
+	sys_dlist_append(l, &thread->base.qnode_dlist);
+}
+
+static ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq,
+					struct k_thread *thread)
+{
+	struct prio_info pos = get_prio_info(thread->base.prio);
+
+	z_priq_bm_insert(&pq->queues[pos.offset_prio], thread);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		if ((thread->base.cpu_mask & BIT(cpu)) != 0) {
+			pq->cpu_count[cpu][pos.offset_prio]++;
+			pq->bitmask[cpu][pos.idx] |= BIT(pos.bit);
+		}
+	}
+#else
+	pq->bitmask[pos.idx] |= BIT(pos.bit);
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+static ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq,
+					   struct k_thread *thread)
+{
+	struct prio_info pos = get_prio_info(thread->base.prio);
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* The mask of a queued thread cannot change */
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		if ((thread->base.cpu_mask & BIT(cpu)) != 0) {
+			if (--pq->cpu_count[cpu][pos.offset_prio] == 0U) {
+				pq->bitmask[cpu][pos.idx] &= ~BIT(pos.bit);
+			}
+		}
+	}
+#else
+	if (sys_dlist_is_empty(&pq->queues[pos.offset_prio])) {
+		pq->bitmask[pos.idx] &= ~BIT(pos.bit);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+static ALWAYS_INLINE struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	int cpu = _current_cpu->id;
+	int offset_prio = z_priq_mq_best_prio(pq->bitmask[cpu]);
+	struct k_thread *thread;
+
+	if (offset_prio < 0) {
+		return NULL;
+	}
+
+	/* There is one allowed on this CPU, only the threads of the same
+	 * priority pinned elsewhere are skipped.
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(&pq->queues[offset_prio], thread, base.qnode_dlist) {
+		if ((thread->base.cpu_mask & BIT(cpu)) != 0) {
+			return thread;
+		}
+	}
+
+	return NULL;
+#else
+	int offset_prio = z_priq_mq_best_prio(pq->bitmask);
+	sys_dnode_t *n;
+
+	if (offset_prio < 0) {
+		return NULL;
+	}
+
+	n = sys_dlist_peek_head(&pq->queues[offset_prio]);
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+#endif /* CONFIG_SCHED_BITMAP */
+
 #ifdef CONFIG_SCHED_CPU_MASK
 static ALWAYS_INLINE struct k_thread *z_priq_dumb_mask_best(sys_dlist_t *pq)
 {
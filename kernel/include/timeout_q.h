@@ -58,6 +58,14 @@ int32_t z_get_next_timeout_expiry(void);
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout);
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Move an active timeout to the queue of another CPU */
+void z_move_timeout(struct _timeout *to, int cpu);
+
+/* Expire the due timeouts of the current CPU, called from the IPI */
+void z_expire_cpu_timeouts(void);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 #else
 
 /* Stubs when !CONFIG_SYS_CLOCK_EXISTS */
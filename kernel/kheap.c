@@ -8,6 +8,7 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
@@ -17,6 +18,11 @@ void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 	z_waitq_init(&heap->wait_q);
 	sys_heap_init(&heap->heap, mem, bytes);
 
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	atomic_clear(&heap->cache_bypass);
+	memset(heap->cache, 0, sizeof(heap->cache));
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
 }
 
@@ -62,12 +68,169 @@ SYS_INIT_NAMED(statics_init_pre, statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_
 SYS_INIT_NAMED(statics_init_post, statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+/* Cached block sizes are 32 << class */
+#define CACHE_MIN_BYTES 32U
+#define CACHE_MAX_BYTES (CACHE_MIN_BYTES << (Z_HEAP_CACHE_CLASSES - 1))
+
+/* Blocks moved at once between a cache and the heap */
+#define CACHE_BATCH (CONFIG_HEAP_PER_CPU_CACHE_SIZE / 2)
+
+/* The lock of a cache is only taken by its CPU, unless the thread was
+ * moved to another CPU meanwhile or the heap is short of memory.  The
+ * lock of the heap is taken after the lock of a cache.
+ */
+static inline struct k_heap_cache *cpu_cache(struct k_heap *heap)
+{
+	return &heap->cache[arch_curr_cpu()->id];
+}
+
+/* Smallest class fitting an allocation of the given size */
+static inline int alloc_class(size_t bytes)
+{
+	int c = 0;
+
+	while ((CACHE_MIN_BYTES << c) < bytes) {
+		c++;
+	}
+
+	return c;
+}
+
+/* Largest class fitting in a block of the given usable size, or -1 if
+ * the block is too small, or too big to be worth caching.
+ */
+static inline int free_class(size_t usable)
+{
+	int c = -1;
+
+	if (usable >= 2 * CACHE_MAX_BYTES) {
+		return -1;
+	}
+
+	while ((c + 1 < Z_HEAP_CACHE_CLASSES) &&
+	       ((CACHE_MIN_BYTES << (c + 1)) <= usable)) {
+		c++;
+	}
+
+	return c;
+}
+
+static void *cache_alloc(struct k_heap *heap, size_t bytes)
+{
+	struct k_heap_cache *cache = cpu_cache(heap);
+	int c = alloc_class(bytes);
+	void *ret = NULL;
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if ((cache->count[c] == 0U) && (atomic_get(&heap->cache_bypass) == 0)) {
+		K_SPINLOCK(&heap->lock) {
+			while (cache->count[c] < CACHE_BATCH) {
+				void *mem = sys_heap_alloc(&heap->heap,
+							   CACHE_MIN_BYTES << c);
+
+				if (mem == NULL) {
+					break;
+				}
+				cache->blocks[c][cache->count[c]++] = mem;
+			}
+		}
+	}
+
+	if (cache->count[c] > 0U) {
+		ret = cache->blocks[c][--cache->count[c]];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_heap *heap, void *mem)
+{
+	struct k_heap_cache *cache;
+	k_spinlock_key_t key;
+	int c;
+
+	if (mem == NULL) {
+		return true;
+	}
+
+	/* The size of an allocated chunk only changes through its owner */
+	c = free_class(sys_heap_usable_size(&heap->heap, mem));
+	if (c < 0) {
+		return false;
+	}
+
+	cache = cpu_cache(heap);
+	key = k_spin_lock(&cache->lock);
+
+	if (atomic_get(&heap->cache_bypass) != 0) {
+		/* Someone may be waiting for this memory */
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	if (cache->count[c] == CONFIG_HEAP_PER_CPU_CACHE_SIZE) {
+		K_SPINLOCK(&heap->lock) {
+			while (cache->count[c] > CACHE_BATCH) {
+				sys_heap_free(&heap->heap,
+					      cache->blocks[c][--cache->count[c]]);
+			}
+		}
+	}
+
+	cache->blocks[c][cache->count[c]++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Give the blocks of all the caches back to the heap.  Called with
+ * cache_bypass set, so that the caches stay empty afterwards: either a
+ * CPU filled its cache before the drain, which then finds the blocks, or
+ * it sees cache_bypass.
+ */
+static void cache_drain(struct k_heap *heap)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_heap_cache *cache = &heap->cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			K_SPINLOCK(&heap->lock) {
+				for (int c = 0; c < Z_HEAP_CACHE_CLASSES; c++) {
+					while (cache->count[c] > 0U) {
+						sys_heap_free(&heap->heap,
+							      cache->blocks[c][--cache->count[c]]);
+					}
+				}
+			}
+		}
+	}
+}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	bool bypass = false;
+
+	if ((bytes > 0U) && (bytes <= CACHE_MAX_BYTES) && (align <= sizeof(void *))) {
+		ret = cache_alloc(heap, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+
+			return ret;
+		}
+	}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -79,6 +242,19 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
 
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+		if ((ret == NULL) && !bypass) {
+			/* The free memory may be in the caches of other CPUs */
+			atomic_inc(&heap->cache_bypass);
+			bypass = true;
+
+			k_spin_unlock(&heap->lock, key);
+			cache_drain(heap);
+			key = k_spin_lock(&heap->lock);
+			continue;
+		}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -102,6 +278,13 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
 
 	k_spin_unlock(&heap->lock, key);
+
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	if (bypass) {
+		atomic_dec(&heap->cache_bypass);
+	}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 	return ret;
 }
 
@@ -120,6 +303,9 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	bool bypass = false;
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
 
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
@@ -130,6 +316,18 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 	while (ret == NULL) {
 		ret = sys_heap_aligned_realloc(&heap->heap, ptr, sizeof(void *), bytes);
 
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+		if ((ret == NULL) && (bytes > 0U) && !bypass) {
+			atomic_inc(&heap->cache_bypass);
+			bypass = true;
+
+			k_spin_unlock(&heap->lock, key);
+			cache_drain(heap);
+			key = k_spin_lock(&heap->lock);
+			continue;
+		}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -143,11 +341,25 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, realloc, heap, ptr, bytes, timeout, ret);
 
 	k_spin_unlock(&heap->lock, key);
+
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	if (bypass) {
+		atomic_dec(&heap->cache_bypass);
+	}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 	return ret;
 }
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_HEAP_PER_CPU_CACHE
+	if (cache_free(heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif /* CONFIG_HEAP_PER_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
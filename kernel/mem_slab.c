@@ -33,6 +33,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+	((struct k_mem_slab_info *)stats)->num_used = z_mem_slab_num_used(slab);
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +49,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	ptr->free_bytes = (slab->info.num_blocks - z_mem_slab_num_used(slab)) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = z_mem_slab_num_used(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -72,7 +73,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = z_mem_slab_num_used(slab);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 	k_spin_unlock(&slab->lock, key);
@@ -179,6 +180,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	atomic_clear(&slab->cache_bypass);
+	memset(slab->cache, 0, sizeof(slab->cache));
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -216,28 +222,170 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 }
 #endif
 
+/* must be locked, with a free block */
+static inline char *take_block(struct k_mem_slab *slab)
+{
+	char *block = slab->free_list;
+
+	slab->free_list = *(char **)block;
+	slab->info.num_used++;
+	__ASSERT((slab->free_list == NULL &&
+		  slab->info.num_used == slab->info.num_blocks) ||
+		 slab_ptr_is_good(slab, slab->free_list),
+		 "slab corruption detected");
+
+	return block;
+}
+
+/* must be locked */
+static inline void update_max_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = MAX(z_mem_slab_num_used(slab),
+				  slab->info.max_used);
+#else
+	ARG_UNUSED(slab);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+/* must be locked */
+static inline void put_block(struct k_mem_slab *slab, char *block)
+{
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+	slab->info.num_used--;
+}
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/* Blocks moved at once between a cache and the free list */
+#define CACHE_BATCH (CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE / 2)
+
+/* The lock of a cache is only taken by its CPU, unless the thread was
+ * moved to another CPU meanwhile or the slab is short of blocks.  The
+ * lock of the slab is taken after the lock of a cache.
+ */
+static inline struct k_mem_slab_cache *cpu_cache(struct k_mem_slab *slab)
+{
+	return &slab->cache[arch_curr_cpu()->id];
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct k_mem_slab_cache *cache = cpu_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool allocated = false;
+
+	if ((cache->count == 0U) && (atomic_get(&slab->cache_bypass) == 0)) {
+		K_SPINLOCK(&slab->lock) {
+			while ((cache->count < CACHE_BATCH) &&
+			       (slab->free_list != NULL)) {
+				cache->blocks[cache->count++] = take_block(slab);
+			}
+		}
+	}
+
+	if (cache->count > 0U) {
+		*mem = cache->blocks[--cache->count];
+		allocated = true;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+		/* The cached blocks do not count, look at all the caches */
+		if (z_mem_slab_num_used(slab) > slab->info.max_used) {
+			K_SPINLOCK(&slab->lock) {
+				update_max_used(slab);
+			}
+		}
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return allocated;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct k_mem_slab_cache *cache = cpu_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if (atomic_get(&slab->cache_bypass) != 0) {
+		/* Someone may be waiting for this block */
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	if (cache->count == CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE) {
+		K_SPINLOCK(&slab->lock) {
+			while (cache->count > CACHE_BATCH) {
+				put_block(slab, cache->blocks[--cache->count]);
+			}
+		}
+	}
+
+	cache->blocks[cache->count++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Give the blocks of all the caches back to the free list.  Called with
+ * cache_bypass set, so that the caches stay empty afterwards: either a
+ * CPU filled its cache before the drain, which then finds the blocks, or
+ * it sees cache_bypass.
+ */
+static void cache_drain(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_cache *cache = &slab->cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			K_SPINLOCK(&slab->lock) {
+				while (cache->count > 0U) {
+					put_block(slab, cache->blocks[--cache->count]);
+				}
+			}
+		}
+	}
+}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	bool bypass = false;
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
-	if (slab->free_list != NULL) {
-		/* take a free block */
-		*mem = slab->free_list;
-		slab->free_list = *(char **)(slab->free_list);
-		slab->info.num_used++;
-		__ASSERT((slab->free_list == NULL &&
-			  slab->info.num_used == slab->info.num_blocks) ||
-			 slab_ptr_is_good(slab, slab->free_list),
-			 "slab corruption detected");
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
 
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->info.max_used = MAX(slab->info.num_used,
-					  slab->info.max_used);
-#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
 
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (slab->free_list == NULL) {
+		/* The free blocks may be in the caches of other CPUs */
+		atomic_inc(&slab->cache_bypass);
+		bypass = true;
+
+		k_spin_unlock(&slab->lock, key);
+		cache_drain(slab);
+		key = k_spin_lock(&slab->lock);
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+	if (slab->free_list != NULL) {
+		/* take a free block */
+		*mem = take_block(slab);
+		update_max_used(slab);
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -253,11 +401,22 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+		/* Only pending after the caches were drained */
+		atomic_dec(&slab->cache_bypass);
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
 	}
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (bypass) {
+		atomic_dec(&slab->cache_bypass);
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 	k_spin_unlock(&slab->lock, key);
@@ -267,11 +426,22 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
 	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -284,9 +454,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 			return;
 		}
 	}
-	*(char **) mem = slab->free_list;
-	slab->free_list = (char *) mem;
-	slab->info.num_used--;
+	put_block(slab, mem);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -300,9 +468,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = z_mem_slab_num_used(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = num_used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - num_used) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -325,7 +494,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = z_mem_slab_num_used(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
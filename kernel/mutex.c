@@ -102,6 +102,68 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* Read without the scheduler lock, this is only a hint */
+static bool owner_is_running(struct k_thread *owner)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (*(struct k_thread *volatile *)&_kernel.cpus[i].current == owner) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Spin while the owner of the mutex is running on another CPU, as it is
+ * likely to unlock it sooner than pending and switching back would take.
+ * Called and returns with the lock held, returns true if the mutex has
+ * been unlocked.  A mutex handed to a pending thread by k_mutex_unlock()
+ * gets an owner that is not running, which makes the spinners pend after
+ * it.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t limit = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+
+	while (owner_is_running(mutex->owner)) {
+		struct k_thread *owner = mutex->owner;
+
+		k_spin_unlock(&lock, *key);
+
+		/* Don't take the lock the owner needs to unlock the mutex */
+		while ((*(struct k_thread *volatile *)&mutex->owner == owner) &&
+		       owner_is_running(owner) &&
+		       ((k_cycle_get_32() - start) < limit)) {
+			arch_spin_relax();
+		}
+
+		*key = k_spin_lock(&lock);
+
+		if (mutex->lock_count == 0U) {
+			return true;
+		}
+
+		if ((k_cycle_get_32() - start) >= limit) {
+			break;
+		}
+	}
+
+	return false;
+}
+#else
+static inline bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(key);
+
+	return false;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -114,7 +176,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current)) ||
+	    (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) && mutex_spin(mutex, &key))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -114,17 +115,20 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread, they come after the threads */
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || (poller->mode == MODE_SET) ||
+		((pending->poller->mode != MODE_SET) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+							   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode == MODE_SET) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+					poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -448,6 +452,8 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
+		} else if (poller->mode == MODE_SET) {
+			retcode = signal_set(event, state);
 		} else {
 			/* Poller is not poll or triggered mode. No action needed.*/
 			;
@@ -813,3 +819,130 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with interrupts locked */
+static int signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set,
+					      poller);
+	struct k_thread *thread;
+
+	ARG_UNUSED(state);
+
+	/* Unregistered from its object by the caller */
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void set_register_event(struct k_poll_set *set,
+			       struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		event->state = state;
+		sys_dlist_append(&set->ready, &event->_node);
+	} else if (event->type != K_POLL_TYPE_IGNORE) {
+		register_event(event, &set->poller);
+	} else {
+		/* Never ready, nothing to do */
+		;
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events)
+{
+	__ASSERT(set != NULL, "NULL set\n");
+	__ASSERT(events != NULL || num_events == 0, "NULL events\n");
+	__ASSERT(num_events >= 0, "<0 events\n");
+
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->rearm);
+	set->events = events;
+	set->num_events = num_events;
+
+	for (int ii = 0; ii < num_events; ii++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		set_register_event(set, &events[ii]);
+		k_spin_unlock(&lock, key);
+	}
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout)
+{
+	struct k_poll_event *event;
+	k_spinlock_key_t key;
+	int num_ready = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+	__ASSERT(max_ready > 0, "no room for ready events\n");
+
+	key = k_spin_lock(&lock);
+
+	/* Only the events returned last time need registering again */
+	while ((event = (struct k_poll_event *)sys_dlist_get(&set->rearm)) != NULL) {
+		set_register_event(set, event);
+	}
+
+	if (sys_dlist_is_empty(&set->ready)) {
+		int swap_rc;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		swap_rc = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		if (swap_rc != 0) {
+			return swap_rc;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	while (num_ready < max_ready) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+
+		sys_dlist_append(&set->rearm, &event->_node);
+		ready[num_ready++] = event;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	/* Another thread may have emptied the set while this one was waking */
+	return (num_ready > 0) ? num_ready : -EAGAIN;
+}
+
+void k_poll_set_clear(struct k_poll_set *set)
+{
+	for (int ii = 0; ii < set->num_events; ii++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		struct k_poll_event *event = &set->events[ii];
+
+		/* Also takes the event off the ready or rearm list */
+		clear_event_registration(event);
+		k_spin_unlock(&lock, key);
+	}
+
+	set->poller.mode = MODE_NONE;
+}
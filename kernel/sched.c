@@ -87,6 +87,107 @@ int32_t z_sched_prio_cmp(struct k_thread *thread_1,
 	return 0;
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* The run queues, like the rest of the scheduler state, are protected by
+ * _sched_spinlock. What they save is the work done under it: a pick only
+ * looks at the local queue and a bounded number of other ones, and a
+ * thread tends to stay on the queue of the CPU whose cache it warmed.
+ */
+
+/* Last queue the steal pass of each CPU looked at */
+static uint8_t runq_steal_last[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Whether a thread made ready would preempt the one running on a CPU */
+static bool runq_preempts(struct k_thread *thread, int cpu)
+{
+	struct k_thread *running = _kernel.cpus[cpu].current;
+
+	return (running == NULL) || z_is_idle_thread_object(running) ||
+	       (z_sched_prio_cmp(thread, running) > 0);
+}
+
+/* Run queue for a thread being made ready: the one of the CPU it last
+ * ran on, as its cache may still be warm there, unless it would only
+ * preempt the thread of the current CPU, or that queue is longer than
+ * the one of the current CPU. Only these two CPUs are looked at, the
+ * other ones find the thread when stealing.
+ */
+static int runq_pick_cpu(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+	int currcpu = _current_cpu->id;
+
+	if ((cpu == currcpu) || runq_preempts(thread, cpu)) {
+		return cpu;
+	}
+
+	if (runq_preempts(thread, currcpu) ||
+	    (_kernel.cpus[cpu].ready_q.count >
+	     _kernel.cpus[currcpu].ready_q.count + 1)) {
+		return currcpu;
+	}
+
+	return cpu;
+}
+
+static void runq_cpu_add(int cpu, struct k_thread *thread)
+{
+	thread->base.runq_cpu = cpu;
+	_priq_run_add(&_kernel.cpus[cpu].ready_q.runq, thread);
+	_kernel.cpus[cpu].ready_q.count++;
+}
+
+static void runq_cpu_remove(int cpu, struct k_thread *thread)
+{
+	_priq_run_remove(&_kernel.cpus[cpu].ready_q.runq, thread);
+	_kernel.cpus[cpu].ready_q.count--;
+}
+
+/* Look at up to CONFIG_SCHED_PER_CPU_RUNQ_STEAL_TRIES other run queues,
+ * continuing from the last one looked at, and move the best thread found
+ * to the local queue if it is better than @p best, the best thread of
+ * the local queue, or if @p best is NULL.
+ */
+static struct k_thread *runq_steal(struct k_thread *best)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int currcpu = _current_cpu->id;
+	int cpu = runq_steal_last[currcpu];
+	int tries = MIN(CONFIG_SCHED_PER_CPU_RUNQ_STEAL_TRIES, (int)num_cpus - 1);
+	struct k_thread *thread, *stolen = NULL;
+	int victim = -1;
+
+	for (int i = 0; i < tries; i++) {
+		cpu = (cpu + 1) % num_cpus;
+		if (cpu == currcpu) {
+			cpu = (cpu + 1) % num_cpus;
+		}
+
+		if (_kernel.cpus[cpu].ready_q.count == 0U) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[cpu].ready_q.runq);
+		if ((stolen == NULL) ?
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0)) :
+		    (z_sched_prio_cmp(thread, stolen) > 0)) {
+			stolen = thread;
+			victim = cpu;
+		}
+	}
+
+	runq_steal_last[currcpu] = cpu;
+
+	if (stolen == NULL) {
+		return best;
+	}
+
+	runq_cpu_remove(victim, stolen);
+	runq_cpu_add(currcpu, stolen);
+
+	return stolen;
+}
+#else
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
 #ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
@@ -106,33 +207,47 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	return &_kernel.ready_q.runq;
 #endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
 }
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	runq_cpu_add(runq_pick_cpu(thread), thread);
+#else
 	_priq_run_add(thread_runq(thread), thread);
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	runq_cpu_remove(thread->base.runq_cpu, thread);
+#else
 	_priq_run_remove(thread_runq(thread), thread);
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Only the local queue, the other ones are looked at by runq_steal() */
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -1012,7 +1127,11 @@ void init_ready_q(struct _ready_q *ready_q)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
+		sys_dlist_init(&ready_q->runq.queues[i]);
+	}
+#elif defined(CONFIG_SCHED_BITMAP)
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -1022,14 +1141,67 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Move a thread from the longest run queue to the shortest one, so that
+ * the threads made ready again go to a less busy CPU. The pass is
+ * skipped rather than made to wait when _sched_spinlock is taken.
+ */
+void z_sched_runq_balance(void)
+{
+#if CONFIG_SCHED_PER_CPU_RUNQ_BALANCE_MS > 0
+	static int64_t next_balance;
+	int64_t now = sys_clock_tick_get();
+	unsigned int num_cpus = arch_num_cpus();
+	int longest = 0, shortest = 0;
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+	if (k_spin_trylock(&_sched_spinlock, &key) != 0) {
+		return;
+	}
+
+	if (now < next_balance) {
+		goto out;
+	}
+
+	next_balance = now + k_ms_to_ticks_ceil64(CONFIG_SCHED_PER_CPU_RUNQ_BALANCE_MS);
+
+	for (int i = 1; i < num_cpus; i++) {
+		if (_kernel.cpus[i].ready_q.count >
+		    _kernel.cpus[longest].ready_q.count) {
+			longest = i;
+		}
+		if (_kernel.cpus[i].ready_q.count <
+		    _kernel.cpus[shortest].ready_q.count) {
+			shortest = i;
+		}
+	}
+
+	if (_kernel.cpus[longest].ready_q.count <=
+	    _kernel.cpus[shortest].ready_q.count + 1) {
+		goto out;
+	}
+
+	thread = _priq_run_best(&_kernel.cpus[longest].ready_q.runq);
+	runq_cpu_remove(longest, thread);
+	runq_cpu_add(shortest, thread);
+	flag_ipi(IPI_CPU_MASK(shortest));
+
+out:
+	k_spin_unlock(&_sched_spinlock, key);
+	signal_pending_ipi();
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ_BALANCE_MS > 0 */
 }
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
 {
@@ -761,6 +761,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif /* CONFIG_SMP */
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Picks the first run queue of the thread, see runq_pick_cpu() */
+	thread_base->cpu = 0U;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
@@ -7,6 +7,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <ksched.h>
+#include <ipi.h>
 #include <timeout_q.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
@@ -14,7 +15,67 @@
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#ifdef CONFIG_TIMEOUT_WHEEL
+/* Hierarchical timing wheel.  Each slot of level L spans 64^L ticks, and
+ * a timeout goes to the lowest level whose 64 slots cover its delay, in
+ * the slot of its expiry tick.  When the tick of the queue enters a slot
+ * of a higher level, the timeouts of that slot are moved down
+ * ("cascaded").  The dticks field of the timeouts holds their absolute
+ * expiry tick.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN BIT64(WHEEL_BITS * WHEEL_LEVELS)
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+struct timeout_q {
+#ifdef CONFIG_TIMEOUT_WHEEL
+	/* The slot lists are only initialized while their bit is set */
+	sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+	uint64_t occupied[WHEEL_LEVELS];
+
+	/* Timeouts too far away for the wheel */
+	sys_dlist_t overflow;
+
+	/* Cached result of first(), NULL if unknown */
+	struct _timeout *first;
+#else
+	/* Sorted by expiry, dticks being relative to the previous timeout */
+	sys_dlist_t list;
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+	/* Tick up to which the timeouts of the queue were expired */
+	uint64_t tick;
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	struct k_spinlock lock;
+
+	/* CPU expiring the timeouts of the queue, if any */
+	struct _cpu *expiring;
+
+	/* The owner CPU was asked to expire the queue */
+	bool kicked;
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+};
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+#define TIMEOUT_Q_INIT(q) { .overflow = SYS_DLIST_STATIC_INIT(&(q).overflow) }
+#else
+#define TIMEOUT_Q_INIT(q) { .list = SYS_DLIST_STATIC_INIT(&(q).list) }
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Timeouts owned by each CPU, expired by that CPU */
+#define CPU_TIMEOUTS_INIT(i, _) TIMEOUT_Q_INIT(cpu_timeouts[i])
+
+static struct timeout_q cpu_timeouts[CONFIG_MP_MAX_NUM_CPUS] = {
+	LISTIFY(CONFIG_MP_MAX_NUM_CPUS, CPU_TIMEOUTS_INIT, (,))
+};
+#else
+static struct timeout_q timeouts = TIMEOUT_Q_INIT(timeouts);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
 static struct k_spinlock timeout_lock;
 
@@ -36,29 +97,295 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+#ifdef CONFIG_TIMEOUT_WHEEL
+static void wheel_insert(struct timeout_q *q, struct _timeout *to)
+{
+	uint64_t delta;
+	sys_dlist_t *list;
+
+	if (to->dticks < (int64_t)q->tick) {
+		to->dticks = q->tick;
+	}
+
+	delta = to->dticks - q->tick;
+
+	if (delta >= WHEEL_SPAN) {
+		list = &q->overflow;
+	} else {
+		int level = (delta < WHEEL_SLOTS) ? 0 :
+			(63 - __builtin_clzll(delta)) / WHEEL_BITS;
+		int slot = (to->dticks >> (WHEEL_BITS * level)) & WHEEL_MASK;
+
+		list = &q->wheel[level][slot];
+		if ((q->occupied[level] & BIT64(slot)) == 0U) {
+			sys_dlist_init(list);
+			q->occupied[level] |= BIT64(slot);
+		}
+	}
+
+	sys_dlist_append(list, &to->node);
+
+	if ((q->first != NULL) && (to->dticks < q->first->dticks)) {
+		q->first = to;
+	}
+}
+
+/* Move the timeouts of a list to the levels matching their delay */
+static void wheel_cascade(struct timeout_q *q, sys_dlist_t *list)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		wheel_insert(q, CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Move the tick of the queue forward, up to the first expiry */
+static void wheel_advance(struct timeout_q *q, uint64_t tick)
+{
+	uint64_t prev = q->tick;
+
+	q->tick = tick;
+
+	if ((tick >> (WHEEL_BITS * (WHEEL_LEVELS - 1))) !=
+	    (prev >> (WHEEL_BITS * (WHEEL_LEVELS - 1)))) {
+		/* Bring the long timeouts which came in range into the wheel */
+		wheel_cascade(q, &q->overflow);
+	}
+
+	/* Only the slots the tick enters may hold timeouts that are now
+	 * closer than their level, the skipped slots are empty as the tick
+	 * does not go past the first expiry.
+	 */
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		uint64_t block = tick >> (WHEEL_BITS * level);
+		int slot = block & WHEEL_MASK;
+
+		if ((block == (prev >> (WHEEL_BITS * level))) ||
+		    ((q->occupied[level] & BIT64(slot)) == 0U)) {
+			continue;
+		}
+
+		q->occupied[level] &= ~BIT64(slot);
+		wheel_cascade(q, &q->wheel[level][slot]);
+	}
+}
+
+static struct _timeout *first(struct timeout_q *q)
+{
+	struct _timeout *best = NULL;
+	struct _timeout *t;
+
+	if (q->first != NULL) {
+		return q->first;
+	}
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		uint64_t occupied = q->occupied[level];
+		uint64_t block = q->tick >> (WHEEL_BITS * level);
+		int start, slot;
+
+		if (occupied == 0U) {
+			continue;
+		}
+
+		/* The current slot of the upper levels only holds timeouts
+		 * a whole turn away, so their first slot is the next one.
+		 */
+		start = (block + (level > 0 ? 1 : 0)) & WHEEL_MASK;
+		occupied = (occupied >> start) |
+			   (occupied << ((WHEEL_SLOTS - start) & WHEEL_MASK));
+		slot = (start + __builtin_ctzll(occupied)) & WHEEL_MASK;
+
+		if ((level > 0) && (best != NULL)) {
+			uint64_t ahead = (slot - block) & WHEEL_MASK;
+
+			block += (ahead == 0U) ? WHEEL_SLOTS : ahead;
+			if (best->dticks < (int64_t)(block << (WHEEL_BITS * level))) {
+				/* Nothing in that slot expires earlier */
+				continue;
+			}
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&q->wheel[level][slot], t, node) {
+			if ((best == NULL) || (t->dticks < best->dticks)) {
+				best = t;
+			}
+
+			if (level == 0) {
+				/* Everything in the slot expires together */
+				break;
+			}
+		}
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&q->overflow, t, node) {
+		if ((best == NULL) || (t->dticks < best->dticks)) {
+			best = t;
+		}
+	}
+
+	q->first = best;
+
+	return best;
+}
+
+static void insert_timeout(struct timeout_q *q, struct _timeout *to,
+			   int64_t expiry)
+{
+	to->dticks = expiry;
+	wheel_insert(q, to);
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	sys_dnode_t *node = &t->node;
+
+	if (node->next == node->prev) {
+		/* Last timeout of its list, which is a slot unless it is
+		 * the overflow list.
+		 */
+		uintptr_t idx = ((uintptr_t)node->next - (uintptr_t)&q->wheel[0][0]) /
+				sizeof(sys_dlist_t);
+
+		if (idx < WHEEL_LEVELS * WHEEL_SLOTS) {
+			q->occupied[idx / WHEEL_SLOTS] &= ~BIT64(idx % WHEEL_SLOTS);
+		}
+	}
+
+	sys_dlist_remove(node);
+
+	if (q->first == t) {
+		q->first = NULL;
+	}
+}
+
+/* Ticks from the tick of the queue to the expiry of its first timeout */
+static inline k_ticks_t first_ticks(struct timeout_q *q, const struct _timeout *t)
+{
+	return t->dticks - q->tick;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout)
+{
+	return timeout->dticks - q->tick;
+}
+
+static inline void advance(struct timeout_q *q, k_ticks_t ticks)
+{
+	wheel_advance(q, q->tick + ticks);
+}
+
+#ifdef CONFIG_ZTEST
+/* Move the queue to another tick, keeping the delays of the timeouts */
+static void rebase(struct timeout_q *q, uint64_t tick)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	struct _timeout *t;
+
+	/* The slots depend on the tick of the queue, start over */
+	while ((t = first(q)) != NULL) {
+		remove_timeout(q, t);
+		t->dticks += tick - q->tick;
+		sys_dlist_append(&pending, &t->node);
+	}
+
+	q->tick = tick;
+	wheel_cascade(q, &pending);
+}
+#endif /* CONFIG_ZTEST */
+#else
+static struct _timeout *first(struct timeout_q *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_q *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static void insert_timeout(struct timeout_q *q, struct _timeout *to,
+			   int64_t expiry)
+{
+	struct _timeout *t;
+
+	to->dticks = expiry - q->tick;
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
+static inline k_ticks_t first_ticks(struct timeout_q *q, const struct _timeout *t)
+{
+	ARG_UNUSED(q);
+
+	return t->dticks;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static inline void advance(struct timeout_q *q, k_ticks_t ticks)
+{
+	struct _timeout *t = first(q);
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+
+	q->tick += ticks;
+}
+
+#ifdef CONFIG_ZTEST
+static inline void rebase(struct timeout_q *q, uint64_t tick)
+{
+	q->tick = tick;
+}
+#endif /* CONFIG_ZTEST */
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -80,25 +407,84 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Each CPU expires the timeouts it armed, from sys_clock_announce() or
+ * from the scheduler IPI when another CPU took the tick.  curr_tick is
+ * the announced tick, the tick of a queue follows it when the queue is
+ * expired.  Lock order is timeout_lock, then the lock of one queue.
+ */
+static inline struct timeout_q *timeout_q_of(const struct _timeout *to)
+{
+	return &cpu_timeouts[to->cpu];
+}
+
+/* Queue whose timeouts each CPU is expiring, if any */
+static struct timeout_q *cpu_expiring[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Current tick for the caller.  curr_tick is already the announced tick
+ * when the queues are expired, so in a timeout callback, or an interrupt
+ * preempting it, this is the tick of the queue being expired, i.e. the
+ * expiry tick of the timeout, as with a single queue.  Must be called
+ * with timeout_lock held and no queue lock.
+ */
+static uint64_t curr_tick_get(void)
+{
+	struct timeout_q *q = cpu_expiring[arch_curr_cpu()->id];
+	uint64_t tick = curr_tick + elapsed();
+
+	if (q != NULL) {
+		K_SPINLOCK(&q->lock) {
+			tick = q->tick;
+		}
+	}
+
+	return tick;
+}
+
+/* must be locked */
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
-	int32_t ticks_elapsed = elapsed();
-	int32_t ret;
+	int64_t next = INT64_MAX;
+	int64_t ticks;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
-		ret = MAX_WAIT;
-	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct timeout_q *q = &cpu_timeouts[i];
+
+		K_SPINLOCK(&q->lock) {
+			struct _timeout *t = first(q);
+
+			/* A kicked queue is expired right away, its owner
+			 * sets the timeout again afterwards.
+			 */
+			if ((t != NULL) && !q->kicked) {
+				next = MIN(next, q->tick + first_ticks(q, t));
+			}
+		}
 	}
 
-	return ret;
+	if (next == INT64_MAX) {
+		return MAX_WAIT;
+	}
+
+	ticks = next - (int64_t)curr_tick - elapsed();
+
+	return (ticks > (int64_t)INT_MAX) ? MAX_WAIT : MAX(0, ticks);
+}
+
+static void set_next_timeout(void)
+{
+	K_SPINLOCK(&timeout_lock) {
+		sys_clock_set_timeout(next_timeout(), false);
+	}
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
+	struct timeout_q *q;
+	bool is_first = false;
+	uint64_t base;
+
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return;
 	}
@@ -110,64 +496,107 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+	/* From a timeout callback, relative to its expiry */
+	base = sys_clock_tick_get();
+
+	/* Owned by the CPU arming it.  The caller may be moved to another
+	 * CPU meanwhile, which is harmless.
+	 */
+	q = &cpu_timeouts[arch_curr_cpu()->id];
+
+	K_SPINLOCK(&q->lock) {
+		int64_t expiry;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			expiry = MAX(Z_TICK_ABS(timeout.ticks), base + 1);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			expiry = base + timeout.ticks + 1;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+		to->cpu = q - cpu_timeouts;
+		insert_timeout(q, to, expiry);
+		is_first = (to == first(q));
+	}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+	if (is_first) {
+		set_next_timeout();
+	}
+}
 
-		if (to == first() && announce_remaining == 0) {
-			sys_clock_set_timeout(next_timeout(), false);
-		}
+/* Lock the queue of a timeout, which may move while not locked */
+static struct timeout_q *lock_timeout_q(const struct _timeout *to,
+					k_spinlock_key_t *key)
+{
+	struct timeout_q *q = timeout_q_of(to);
+
+	*key = k_spin_lock(&q->lock);
+	while (q != timeout_q_of(to)) {
+		k_spin_unlock(&q->lock, *key);
+		q = timeout_q_of(to);
+		*key = k_spin_lock(&q->lock);
 	}
+
+	return q;
 }
 
 int z_abort_timeout(struct _timeout *to)
 {
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_timeout_q(to, &key);
 	int ret = -EINVAL;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
-			ret = 0;
-		}
+	if (sys_dnode_is_linked(&to->node)) {
+		remove_timeout(q, to);
+		ret = 0;
 	}
 
+	k_spin_unlock(&q->lock, key);
+
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+void z_move_timeout(struct _timeout *to, int cpu)
 {
-	k_ticks_t ticks = 0;
+	struct timeout_q *src, *dst = &cpu_timeouts[cpu];
+	k_spinlock_key_t key, key2;
+	bool moved = false;
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
+	src = lock_timeout_q(to, &key);
+	if ((src == dst) || !sys_dnode_is_linked(&to->node)) {
+		k_spin_unlock(&src->lock, key);
+		return;
 	}
 
-	return ticks;
+	/* Both queues are locked in CPU order, the source one again */
+	if (dst < src) {
+		k_spin_unlock(&src->lock, key);
+		key = k_spin_lock(&dst->lock);
+		key2 = k_spin_lock(&src->lock);
+	} else {
+		key2 = k_spin_lock(&dst->lock);
+	}
+
+	if ((timeout_q_of(to) == src) && sys_dnode_is_linked(&to->node)) {
+		int64_t expiry = src->tick + timeout_rem(src, to);
+
+		remove_timeout(src, to);
+		to->cpu = cpu;
+		insert_timeout(dst, to, expiry);
+		moved = true;
+	}
+
+	if (dst < src) {
+		k_spin_unlock(&src->lock, key2);
+		k_spin_unlock(&dst->lock, key);
+	} else {
+		k_spin_unlock(&dst->lock, key2);
+		k_spin_unlock(&src->lock, key);
+	}
+
+	if (moved) {
+		set_next_timeout();
+	}
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -175,9 +604,15 @@ k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 	k_ticks_t ticks = 0;
 
 	K_SPINLOCK(&timeout_lock) {
+		uint64_t now = curr_tick_get();
+		k_spinlock_key_t key;
+		struct timeout_q *q = lock_timeout_q(timeout, &key);
+
 		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
+			ticks = q->tick + timeout_rem(q, timeout) - now;
 		}
+
+		k_spin_unlock(&q->lock, key);
 	}
 
 	return ticks;
@@ -188,25 +623,233 @@ k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 	k_ticks_t ticks = 0;
 
 	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick;
+		uint64_t now = curr_tick_get();
+		k_spinlock_key_t key;
+		struct timeout_q *q = lock_timeout_q(timeout, &key);
+
 		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
+			ticks = q->tick + timeout_rem(q, timeout);
+		} else {
+			ticks = now;
 		}
+
+		k_spin_unlock(&q->lock, key);
 	}
 
 	return ticks;
 }
 
-int32_t z_get_next_timeout_expiry(void)
+/* Expire the timeouts of a queue up to tick */
+static void expire_timeouts(struct timeout_q *q, uint64_t tick)
 {
-	int32_t ret = (int32_t) K_TICKS_FOREVER;
+	int cpu = arch_curr_cpu()->id;
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	struct timeout_q *prev = cpu_expiring[cpu];
+	struct _timeout *t;
+
+	q->kicked = false;
+
+	if (q->expiring != NULL) {
+		/* Already being expired, e.g. from an interrupted callback */
+		k_spin_unlock(&q->lock, key);
+		return;
+	}
+
+	q->expiring = arch_curr_cpu();
+	cpu_expiring[cpu] = q;
+
+	for (t = first(q);
+	     (t != NULL) && (q->tick + first_ticks(q, t) <= tick);
+	     t = first(q)) {
+		advance(q, first_ticks(q, t));
+		t->dticks = 0;
+		remove_timeout(q, t);
+
+		k_spin_unlock(&q->lock, key);
+		t->fn(t);
+		key = k_spin_lock(&q->lock);
+	}
+
+	if (q->tick < tick) {
+		advance(q, tick - q->tick);
+	}
+
+	q->expiring = NULL;
+	cpu_expiring[cpu] = prev;
+
+	k_spin_unlock(&q->lock, key);
+}
+
+void z_expire_cpu_timeouts(void)
+{
+	struct timeout_q *q = &cpu_timeouts[arch_curr_cpu()->id];
+	bool kicked = false;
+	uint64_t tick;
+
+	K_SPINLOCK(&q->lock) {
+		kicked = q->kicked;
+	}
+
+	if (!kicked) {
+		/* Not for us, or already expired */
+		return;
+	}
 
 	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout();
+		tick = curr_tick;
+	}
+
+	expire_timeouts(q, tick);
+
+	set_next_timeout();
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	int cpu = arch_curr_cpu()->id;
+	uint64_t tick;
+
+	K_SPINLOCK(&timeout_lock) {
+		curr_tick += ticks;
+		tick = curr_tick;
+	}
+
+	expire_timeouts(&cpu_timeouts[cpu], tick);
+
+	/* Have the other CPUs expire their due timeouts, or do it here if
+	 * they cannot be interrupted.
+	 */
+	for (int i = 0; i < arch_num_cpus(); i++) {
+		struct timeout_q *q = &cpu_timeouts[i];
+		bool due = false;
+
+		if (i == cpu) {
+			continue;
+		}
+
+		K_SPINLOCK(&q->lock) {
+			struct _timeout *t = first(q);
+
+			due = (t != NULL) && (q->tick + first_ticks(q, t) <= tick);
+			q->kicked = due && IS_ENABLED(CONFIG_SCHED_IPI_SUPPORTED);
+		}
+
+		if (due && IS_ENABLED(CONFIG_SCHED_IPI_SUPPORTED)) {
+			flag_ipi(IPI_CPU_MASK(i));
+		} else if (due) {
+			expire_timeouts(q, tick);
+		}
+	}
+
+	signal_pending_ipi();
+
+	set_next_timeout();
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	z_sched_runq_balance();
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+}
+#else
+/* must be locked */
+static uint64_t curr_tick_get(void)
+{
+	return curr_tick + elapsed();
+}
+
+/* must be locked */
+static int32_t next_timeout(void)
+{
+	struct _timeout *to = first(&timeouts);
+	int32_t ticks_elapsed = elapsed();
+	int32_t ret;
+
+	if ((to == NULL) ||
+	    ((int64_t)(first_ticks(&timeouts, to) - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, first_ticks(&timeouts, to) - ticks_elapsed);
 	}
+
 	return ret;
 }
 
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	K_SPINLOCK(&timeout_lock) {
+		k_ticks_t ticks;
+
+		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
+		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
+		} else {
+			ticks = timeout.ticks + 1 + elapsed();
+		}
+
+		insert_timeout(&timeouts, to, curr_tick + ticks);
+
+		if (to == first(&timeouts) && announce_remaining == 0) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+	}
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	int ret = -EINVAL;
+
+	K_SPINLOCK(&timeout_lock) {
+		if (sys_dnode_is_linked(&to->node)) {
+			remove_timeout(&timeouts, to);
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	K_SPINLOCK(&timeout_lock) {
+		if (!z_is_inactive_timeout(timeout)) {
+			ticks = timeout_rem(&timeouts, timeout) - elapsed();
+		}
+	}
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	K_SPINLOCK(&timeout_lock) {
+		ticks = curr_tick;
+		if (!z_is_inactive_timeout(timeout)) {
+			ticks += timeout_rem(&timeouts, timeout);
+		}
+	}
+
+	return ticks;
+}
+
 void sys_clock_announce(int32_t ticks)
 {
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
@@ -227,14 +870,15 @@ void sys_clock_announce(int32_t ticks)
 
 	struct _timeout *t;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+	for (t = first(&timeouts);
+	     (t != NULL) && (first_ticks(&timeouts, t) <= announce_remaining);
+	     t = first(&timeouts)) {
+		int dt = first_ticks(&timeouts, t);
 
 		curr_tick += dt;
+		advance(&timeouts, dt);
 		t->dticks = 0;
-		remove_timeout(t);
+		remove_timeout(&timeouts, t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -242,11 +886,8 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
 	curr_tick += announce_remaining;
+	advance(&timeouts, announce_remaining);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(), false);
@@ -256,6 +897,21 @@ void sys_clock_announce(int32_t ticks)
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
 #endif /* CONFIG_TIMESLICING */
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	z_sched_runq_balance();
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+}
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	int32_t ret = (int32_t) K_TICKS_FOREVER;
+
+	K_SPINLOCK(&timeout_lock) {
+		ret = next_timeout();
+	}
+	return ret;
 }
 
 int64_t sys_clock_tick_get(void)
@@ -263,7 +919,7 @@ int64_t sys_clock_tick_get(void)
 	uint64_t t = 0U;
 
 	K_SPINLOCK(&timeout_lock) {
-		t = curr_tick + elapsed();
+		t = curr_tick_get();
 	}
 	return t;
 }
@@ -330,7 +986,20 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	K_SPINLOCK(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_PER_CPU
+		for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+			struct timeout_q *q = &cpu_timeouts[i];
+
+			K_SPINLOCK(&q->lock) {
+				rebase(q, tick + (q->tick - curr_tick));
+			}
+		}
+#else
+		rebase(&timeouts, tick);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+		curr_tick = tick;
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -252,7 +252,7 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  * thread (chained submission).
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Caller must notify queue of pending work.
  *
  * @param queue the queue to which work should be submitted.  This may
  * be null, in which case the submission will fail.
@@ -292,7 +292,6 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
 	}
 
 	return ret;
@@ -306,7 +305,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * * the candidate queue rejects the submission.
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
+ * Caller must notify queue of pending work, see submit_to_queue_locked().
  *
  * @param work the work structure to be submitted
 
@@ -324,8 +323,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  */
-static int submit_to_queue_locked(struct k_work *work,
-				  struct k_work_q **queuep)
+static int submit_to_queue_quiet_locked(struct k_work *work,
+					struct k_work_q **queuep)
 {
 	int ret = 0;
 
@@ -371,6 +370,23 @@ static int submit_to_queue_locked(struct k_work *work,
 	return ret;
 }
 
+/* Attempt to submit work to a queue, see submit_to_queue_quiet_locked().
+ *
+ * Invoked with work lock held.
+ * Conditionally notifies queue.
+ */
+static int submit_to_queue_locked(struct k_work *work,
+				  struct k_work_q **queuep)
+{
+	int ret = submit_to_queue_quiet_locked(work, queuep);
+
+	if (ret > 0) {
+		(void)notify_queue_locked(*queuep);
+	}
+
+	return ret;
+}
+
 /* Submit work to a queue but do not yield the current thread.
  *
  * Intended for internal use.
@@ -418,6 +434,52 @@ int k_work_submit_to_queue(struct k_work_q *queue,
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				  struct k_work **works, size_t count)
+{
+	__ASSERT_NO_MSG(queue != NULL);
+	__ASSERT_NO_MSG((works != NULL) || (count == 0));
+
+	int queued = 0;
+	int err = 0;
+	bool notify = false;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *target = queue;
+
+		__ASSERT_NO_MSG(works[i]->handler != NULL);
+
+		int rc = submit_to_queue_quiet_locked(works[i], &target);
+
+		if (rc < 0) {
+			err = rc;
+		} else if (rc > 0) {
+			queued++;
+
+			/* A running item goes to the queue running it */
+			if (target == queue) {
+				notify = true;
+			} else {
+				(void)notify_queue_locked(target);
+			}
+		}
+	}
+
+	/* A single wakeup for the whole batch */
+	if (notify) {
+		(void)notify_queue_locked(queue);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (queued > 0) {
+		z_reschedule_unlocked();
+	}
+
+	return ((queued > 0) || (err == 0)) ? queued : err;
+}
+
 int k_work_submit(struct k_work *work)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, submit, work);
@@ -429,6 +491,126 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+#ifdef CONFIG_WORK_POOL
+/* Take the oldest work item of another queue of the pool.
+ *
+ * Invoked with work lock held, by a worker without pending work.
+ *
+ * A flusher is never taken, as it is bound to the item running on its
+ * queue, nor an item resubmitted while running, which must run again on
+ * the same queue.  The flushers queued right after the item go with it so
+ * that they still complete after it.
+ *
+ * @param queue the queue taking the work.
+ *
+ * @return the node of the work item, removed from its queue and now
+ * owned by @p queue, or NULL if none can be taken.
+ */
+static sys_snode_t *pool_steal_locked(struct k_work_q *queue)
+{
+	struct k_work_pool *pool = queue->pool;
+	size_t idx = queue - pool->queues;
+
+	for (size_t i = 1; i < pool->num_queues; i++) {
+		struct k_work_q *victim = &pool->queues[(idx + i) % pool->num_queues];
+		sys_snode_t *node = sys_slist_peek_head(&victim->pending);
+		struct k_work *work;
+
+		if (node == NULL) {
+			continue;
+		}
+
+		work = CONTAINER_OF(node, struct k_work, node);
+		if ((flags_get(&work->flags)
+		     & (K_WORK_FLUSHING | K_WORK_RUNNING)) != 0U) {
+			continue;
+		}
+
+		(void)sys_slist_get(&victim->pending);
+		work->queue = queue;
+
+		node = sys_slist_peek_head(&victim->pending);
+		while ((node != NULL) &&
+		       flag_test(&CONTAINER_OF(node, struct k_work, node)->flags,
+				 K_WORK_FLUSHING_BIT)) {
+			(void)sys_slist_get(&victim->pending);
+			sys_slist_append(&queue->pending, node);
+			node = sys_slist_peek_head(&victim->pending);
+		}
+
+		return &work->node;
+	}
+
+	return NULL;
+}
+
+/* Queue of the pool a work item should be submitted to: the one of the
+ * calling worker, so that work it generates stays local, or else the one
+ * of the current CPU.
+ */
+static struct k_work_q *pool_local_queue(struct k_work_pool *pool)
+{
+	if (!k_is_in_isr()) {
+		for (size_t i = 0; i < pool->num_queues; i++) {
+			if (_current == &pool->queues[i].thread) {
+				return &pool->queues[i];
+			}
+		}
+	}
+
+	return &pool->queues[arch_curr_cpu()->id % pool->num_queues];
+}
+
+void k_work_pool_start(struct k_work_pool *pool, struct k_work_q *queues,
+		       size_t num_queues, k_thread_stack_t *stacks,
+		       size_t stack_size, int prio,
+		       const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(queues != NULL);
+	__ASSERT_NO_MSG(num_queues > 0);
+
+	pool->queues = queues;
+	pool->num_queues = num_queues;
+
+	for (size_t i = 0; i < num_queues; i++) {
+		queues[i].pool = pool;
+		k_work_queue_start(&queues[i],
+				   &stacks[K_THREAD_STACK_LEN(stack_size) * i],
+				   stack_size, prio, cfg);
+	}
+}
+
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(work != NULL);
+	__ASSERT_NO_MSG(work->handler != NULL);
+
+	struct k_work_q *queue = pool_local_queue(pool);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret = submit_to_queue_locked(work, &queue);
+
+	/* Wake up an idle worker to take the item if its queue is busy */
+	if ((ret > 0) && flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)) {
+		for (size_t i = 0; i < pool->num_queues; i++) {
+			if ((&pool->queues[i] != queue) &&
+			    notify_queue_locked(&pool->queues[i])) {
+				break;
+			}
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ret > 0) {
+		z_reschedule_unlocked();
+	}
+
+	return ret;
+}
+#endif /* CONFIG_WORK_POOL */
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -609,6 +791,27 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+/* Mark a work item as no longer running and deal with any cancellation
+ * and flushing issued while it was running.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue that ran the work
+ * @param work the work that completed
+ */
+static void finish_work_locked(struct k_work_q *queue, struct k_work *work)
+{
+	flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		finalize_flush_locked(work);
+	}
+	if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+		finalize_cancel_locked(work);
+	}
+
+	flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -619,6 +822,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	ARG_UNUSED(p3);
 
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+	struct k_work *done = NULL;
 
 	while (true) {
 		sys_snode_t *node;
@@ -627,8 +831,23 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
+		/* In batch mode the previous item is finished here, with
+		 * the lock also used to take the next one.
+		 */
+		if (done != NULL) {
+			finish_work_locked(queue, done);
+			done = NULL;
+		}
+
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
+#ifdef CONFIG_WORK_POOL
+		if ((node == NULL) && (queue->pool != NULL) &&
+		    ((flags_get(&queue->flags)
+		      & (K_WORK_QUEUE_DRAIN | K_WORK_QUEUE_PLUGGED)) == 0U)) {
+			node = pool_steal_locked(queue);
+		}
+#endif /* CONFIG_WORK_POOL */
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -682,11 +901,20 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			continue;
 		}
 
+		/* In batch mode, finish it when taking the next one */
+		if (flag_test(&queue->flags, K_WORK_QUEUE_BATCH_BIT)) {
+			done = work;
+		}
+
 		k_spin_unlock(&lock, key);
 
 		__ASSERT_NO_MSG(handler != NULL);
 		handler(work);
 
+		if (done != NULL) {
+			continue;
+		}
+
 		/* Mark the work item as no longer running and deal
 		 * with any cancellation and flushing issued while it
 		 * was running.  Clear the BUSY flag and optionally
@@ -694,15 +922,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		 */
 		key = k_spin_lock(&lock);
 
-		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
-		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
-			finalize_flush_locked(work);
-		}
-		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
-			finalize_cancel_locked(work);
-		}
-
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		finish_work_locked(queue, work);
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -747,6 +967,10 @@ void k_work_queue_start(struct k_work_q *queue,
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
 
+	if ((cfg != NULL) && cfg->batch) {
+		flags |= K_WORK_QUEUE_BATCH;
+	}
+
 	/* It hasn't actually been started yet, but all the state is in place
 	 * so we can submit things and once the thread gets control it's ready
 	 * to roll.
@@ -6,6 +6,7 @@
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
+#include <string.h>
 #include "heap.h"
 
 struct z_heap_stress_rec {
@@ -18,6 +19,7 @@ struct z_heap_stress_rec {
 	size_t blocks_alloced;
 	size_t bytes_alloced;
 	uint32_t target_percent;
+	uint32_t *lat_hist;
 };
 
 struct z_heap_stress_block {
@@ -25,6 +27,56 @@ struct z_heap_stress_block {
 	size_t sz;
 };
 
+/* Histogram of the alloc latencies: each power of two is split into
+ * 2^LAT_SUB_BITS buckets, which is good for percentiles within 25%.
+ * It is kept in the scratch memory of each run, so that the rig can
+ * run in several threads at once.
+ */
+#define LAT_SUB_BITS 2
+#define LAT_BUCKETS (32 << LAT_SUB_BITS)
+
+static int lat_bucket(uint32_t cycles)
+{
+	int msb;
+
+	if (cycles < BIT(LAT_SUB_BITS)) {
+		return cycles;
+	}
+
+	msb = 31 - __builtin_clz(cycles);
+
+	return ((msb - LAT_SUB_BITS + 1) << LAT_SUB_BITS) |
+	       ((cycles >> (msb - LAT_SUB_BITS)) & BIT_MASK(LAT_SUB_BITS));
+}
+
+/* Lowest latency of a bucket */
+static uint32_t lat_bucket_cycles(int b)
+{
+	int msb = (b >> LAT_SUB_BITS) + LAT_SUB_BITS - 1;
+
+	if (b < BIT(LAT_SUB_BITS)) {
+		return b;
+	}
+
+	return (BIT(LAT_SUB_BITS) | (b & BIT_MASK(LAT_SUB_BITS))) << (msb - LAT_SUB_BITS);
+}
+
+static uint32_t lat_percentile(const uint32_t *lat_hist, uint32_t count,
+			       uint32_t pct)
+{
+	uint32_t rank = (uint32_t)(((uint64_t)count * pct + 99) / 100);
+	uint32_t seen = 0;
+
+	for (int b = 0; b < LAT_BUCKETS; b++) {
+		seen += lat_hist[b];
+		if ((seen >= rank) && (seen > 0)) {
+			return lat_bucket_cycles(b);
+		}
+	}
+
+	return 0;
+}
+
 /* Very simple LCRNG (from https://nuclear.llnl.gov/CNP/rng/rngman/node4.html)
  *
  * Here to guarantee cross-platform test repeatability.
@@ -112,23 +164,33 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     int target_percent,
 		     struct z_heap_stress_result *result)
 {
+	size_t hist_bytes = LAT_BUCKETS * sizeof(uint32_t);
 	struct z_heap_stress_rec sr = {
 	       .alloc_fn = alloc_fn,
 	       .free_fn = free_fn,
 	       .arg = arg,
 	       .total_bytes = total_bytes,
-	       .blocks = scratch_mem,
-	       .nblocks = scratch_bytes / sizeof(struct z_heap_stress_block),
+	       .blocks = (void *)((uint8_t *)scratch_mem + hist_bytes),
+	       .nblocks = (scratch_bytes - hist_bytes) / sizeof(struct z_heap_stress_block),
 	       .target_percent = target_percent,
+	       .lat_hist = scratch_mem,
 	};
 
+	__ASSERT(scratch_bytes > hist_bytes, "scratch memory too small");
+
 	*result = (struct z_heap_stress_result) {0};
+	memset(sr.lat_hist, 0, hist_bytes);
 
 	for (uint32_t i = 0; i < op_count; i++) {
 		if (rand_alloc_choice(&sr)) {
 			size_t sz = rand_alloc_size(&sr);
+			uint32_t start = k_cycle_get_32();
 			void *p = sr.alloc_fn(sr.arg, sz);
+			uint32_t cycles = k_cycle_get_32() - start;
 
+			sr.lat_hist[lat_bucket(cycles)]++;
+			result->total_alloc_cycles += cycles;
+			result->alloc_cycles_max = MAX(result->alloc_cycles_max, cycles);
 			result->total_allocs++;
 			if (p != NULL) {
 				result->successful_allocs++;
@@ -146,8 +208,16 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
 			sr.blocks_alloced--;
 			sr.bytes_alloced -= sz;
+
+			uint32_t start = k_cycle_get_32();
+
 			sr.free_fn(sr.arg, p);
+			result->total_free_cycles += k_cycle_get_32() - start;
 		}
 		result->accumulated_in_use_bytes += sr.bytes_alloced;
 	}
+
+	result->alloc_cycles_p50 = lat_percentile(sr.lat_hist, result->total_allocs, 50);
+	result->alloc_cycles_p90 = lat_percentile(sr.lat_hist, result->total_allocs, 90);
+	result->alloc_cycles_p99 = lat_percentile(sr.lat_hist, result->total_allocs, 99);
 }
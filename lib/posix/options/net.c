@@ -6,6 +6,7 @@
  */
 
 #include <ctype.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -355,6 +356,18 @@ ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+	     struct timespec *timeout)
+{
+	/* Only SO_RCVTIMEO is supported for bounding the wait */
+	if (timeout != NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 ssize_t send(int sock, const void *buf, size_t len, int flags)
 {
 	return zsock_send(sock, buf, len, flags);
@@ -365,6 +378,11 @@ ssize_t sendmsg(int sock, const struct msghdr *message, int flags)
 	return zsock_sendmsg(sock, message, flags);
 }
 
+int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 ssize_t sendto(int sock, const void *buf, size_t len, int flags, const struct sockaddr *dest_addr,
 	       socklen_t addrlen)
 {
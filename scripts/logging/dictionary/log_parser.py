@@ -31,7 +31,9 @@ def parse_args():
     argparser = argparse.ArgumentParser(allow_abbrev=False)
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", nargs="+",
+                           help="Log Data file(s), parsed in the given order "
+                                "(e.g. rotated log files, oldest first)")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
@@ -42,7 +44,7 @@ def parse_args():
     return argparser.parse_args()
 
 
-def read_log_file(args):
+def read_log_file(args, logfname):
     """
     Read the log from file
     """
@@ -52,11 +54,11 @@ def read_log_file(args):
     if args.hex:
         if args.rawhex:
             # Simply log file with only hexadecimal data
-            logdata = dictionary_parser.utils.convert_hex_file_to_bin(args.logfile)
+            logdata = dictionary_parser.utils.convert_hex_file_to_bin(logfname)
         else:
             hexdata = ''
 
-            with open(args.logfile, "r", encoding="iso-8859-1") as hexfile:
+            with open(logfname, "r", encoding="iso-8859-1") as hexfile:
                 for line in hexfile.readlines():
                     hexdata += line.strip()
 
@@ -89,9 +91,9 @@ def read_log_file(args):
 
             logdata = binascii.unhexlify(hexdata[:idx])
     else:
-        logfile = open(args.logfile, "rb")
+        logfile = open(logfname, "rb")
         if not logfile:
-            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", args.logfile)
+            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", logfname)
             sys.exit(1)
 
         logdata = logfile.read()
@@ -118,10 +120,18 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
-    logdata = read_log_file(args)
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
-        sys.exit(1)
+    # The file system backend writes a message in one piece when it fits
+    # in its output buffer, and drops a partial write when it makes room
+    # by deleting the oldest file. Its rotated files then end on a message
+    # boundary and can simply be joined.
+    logdata = b''
+    for logfname in args.logfile:
+        filedata = read_log_file(args, logfname)
+        if filedata is None:
+            logger.error("ERROR: cannot read log from file: %s, exiting...", logfname)
+            sys.exit(1)
+
+        logdata += filedata
 
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
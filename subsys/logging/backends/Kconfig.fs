@@ -67,4 +67,34 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_BUFFERED
+	bool "Buffered writes"
+	help
+	  When enabled, the formatted log output is accumulated in a RAM buffer
+	  which is written to the log file, and synced, only when it is full,
+	  when LOG_BACKEND_FS_FLUSH_TIMEOUT_MS have elapsed since data was
+	  added to the empty buffer, or on panic. This saves a flash program
+	  and a metadata commit for every log message, at the cost of losing
+	  the buffered messages on a reset. The flush after the timeout is
+	  done from the system workqueue.
+
+if LOG_BACKEND_FS_BUFFERED
+
+config LOG_BACKEND_FS_BUFFER_SIZE
+	int "Size of the RAM buffer"
+	default 1024
+	range 64 65536
+	help
+	  Size of the RAM buffer (in bytes). It is limited to the log file
+	  size so that a flush fits in a log file.
+
+config LOG_BACKEND_FS_FLUSH_TIMEOUT_MS
+	int "Maximum time logs stay in the RAM buffer"
+	default 1000
+	help
+	  Time (in milliseconds) after which the RAM buffer is flushed when
+	  it does not fill up.
+
+endif # LOG_BACKEND_FS_BUFFERED
+
 endif # LOG_BACKEND_FS
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_fs.h>
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_std.h>
 #include <assert.h>
@@ -35,6 +36,19 @@ static int get_log_file_id(struct fs_dirent *ent);
 static uint32_t log_format_current = CONFIG_LOG_BACKEND_FS_OUTPUT_DEFAULT;
 #endif
 
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+#define WRITE_BUF_SIZE MIN(CONFIG_LOG_BACKEND_FS_BUFFER_SIZE, \
+			   CONFIG_LOG_BACKEND_FS_FILE_SIZE)
+
+static void flush_work_handler(struct k_work *work);
+
+static uint8_t write_buf[WRITE_BUF_SIZE];
+static size_t write_buf_len;
+static atomic_t flushing;
+static K_MUTEX_DEFINE(write_buf_mutex);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+#endif
+
 static int check_log_volume_available(void)
 {
 	int index = 0;
@@ -146,7 +160,7 @@ close_dir:
 	return rc;
 }
 
-int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+static int file_write(uint8_t *data, size_t length)
 {
 	int rc;
 	struct fs_file_t *f = &fs_file;
@@ -185,6 +199,18 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 		if (rc >= 0) {
 			if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OVERWRITE) &&
 			    (rc != length)) {
+				/* The whole chunk is written again once the
+				 * oldest log is deleted, so drop the part that
+				 * made it. A message cut in the middle would
+				 * desynchronize the dictionary log parser.
+				 */
+				if (rc > 0) {
+					off_t pos = fs_tell(f) - rc;
+
+					(void)fs_truncate(f, pos);
+					(void)fs_seek(f, pos, FS_SEEK_SET);
+				}
+
 				del_oldest_log();
 
 				return 0;
@@ -225,6 +251,97 @@ on_error:
 	return length;
 }
 
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+static int buffer_flush(void)
+{
+	uint8_t *data = write_buf;
+	size_t length = write_buf_len;
+	int retries = 0;
+	int rc = 0;
+
+	/* Not when panic() interrupted a write to the file, nor again on a
+	 * fault in the file system while flushing from panic().
+	 */
+	if (!atomic_cas(&flushing, 0, 1)) {
+		return 0;
+	}
+
+	/* Like log_output, retry the rest of the data when the oldest log
+	 * file was deleted, or a new file allocated, to make room. Each log
+	 * file can be deleted once at most, after that the data is dropped
+	 * like a record which does not fit without buffering.
+	 */
+	while (length > 0) {
+		int written = file_write(data, length);
+
+		if (written == 0 &&
+		    ++retries > CONFIG_LOG_BACKEND_FS_FILES_LIMIT) {
+			rc = -ENOSPC;
+			break;
+		}
+
+		data += written;
+		length -= written;
+	}
+
+	write_buf_len = 0;
+	atomic_clear(&flushing);
+
+	return rc;
+}
+
+int log_backend_fs_flush(void)
+{
+	int rc;
+
+	k_mutex_lock(&write_buf_mutex, K_FOREVER);
+	rc = buffer_flush();
+	k_mutex_unlock(&write_buf_mutex);
+
+	return rc;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)log_backend_fs_flush();
+}
+#endif /* CONFIG_LOG_BACKEND_FS_BUFFERED */
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+	k_mutex_lock(&write_buf_mutex, K_FOREVER);
+
+	if ((write_buf_len + length) > sizeof(write_buf)) {
+		(void)buffer_flush();
+	}
+
+	if (length > sizeof(write_buf)) {
+		atomic_set(&flushing, 1);
+		length = file_write(data, length);
+		atomic_clear(&flushing);
+	} else {
+		if (write_buf_len == 0) {
+			(void)k_work_schedule(&flush_work,
+					      K_MSEC(CONFIG_LOG_BACKEND_FS_FLUSH_TIMEOUT_MS));
+		}
+
+		memcpy(&write_buf[write_buf_len], data, length);
+		write_buf_len += length;
+	}
+
+	k_mutex_unlock(&write_buf_mutex);
+
+	return length;
+#else
+	return file_write(data, length);
+#endif
+}
+
 static int get_log_file_id(struct fs_dirent *ent)
 {
 	size_t len;
@@ -461,6 +578,15 @@ static void log_backend_fs_init(const struct log_backend *const backend)
 
 static void panic(struct log_backend const *const backend)
 {
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+	/* The buffered logs are the last ones before the panic, so they are
+	 * written from the panic context. The mutex cannot be taken here: if
+	 * the panic interrupted a write to the file, buffer_flush() drops the
+	 * buffer instead.
+	 */
+	(void)buffer_flush();
+#endif
+
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
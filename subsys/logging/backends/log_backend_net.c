@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_net.h>
 #include <zephyr/net/hostname.h>
 #include <zephyr/net/net_if.h>
@@ -57,7 +58,10 @@ static int line_out(uint8_t *data, size_t length, void *output_ctx)
 #if defined(CONFIG_NET_TCP)
 	char len[sizeof("123456789")];
 
-	if (ctx->is_tcp) {
+	/* Dictionary messages are framed by their header, and the stream is
+	 * passed as is to the offline parser.
+	 */
+	if (ctx->is_tcp && (log_format_current != LOG_OUTPUT_DICT)) {
 		(void)snprintk(len, sizeof(len), "%zu ", length);
 		io_vector[pos].iov_base = (void *)len;
 		io_vector[pos].iov_len = strlen(len);
@@ -216,6 +220,19 @@ static void process(const struct log_backend *const backend,
 	log_output_func(&log_output_net, &msg->log, flags);
 }
 
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	/* Only the dictionary format reports dropped messages, syslog has no
+	 * record for it.
+	 */
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    (log_format_current == LOG_OUTPUT_DICT) && net_init_done && !panic_mode) {
+		log_dict_output_dropped_process(&log_output_net, cnt);
+	}
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	log_format_current = log_type;
@@ -341,6 +358,7 @@ const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
 	.init = init_net,
 	.process = process,
+	.dropped = dropped,
 	.format_set = format_set,
 };
 
@@ -138,6 +138,20 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFER
+/* CPU 0 uses log_buffer, entry i of the arrays is used by CPU i + 1. The
+ * names sort after the ones of log_buffer and log_msg_ptr, which keeps the
+ * two sections in the same order.
+ */
+#define CPU_BUFFERS (CONFIG_MP_MAX_NUM_CPUS - 1)
+
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_msg_ptr_cpu, CPU_BUFFERS);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       log_buffer_cpu, CPU_BUFFERS);
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[CPU_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -539,6 +553,13 @@ static inline bool z_log_unordered_pending(void)
 	return IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && unordered_cnt;
 }
 
+/* True if messages are merged from more than one buffer */
+static inline bool multi_buffer(size_t len)
+{
+	return (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) ||
+		IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFER)) && (len > 1);
+}
+
 bool z_impl_log_process(void)
 {
 	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
@@ -639,6 +660,44 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFER
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < CPU_BUFFERS; i++) {
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&log_buffer_cpu[i], &config);
+	}
+#endif
+}
+
+/* Buffer to allocate messages from */
+static struct mpsc_pbuf_buffer *local_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFER
+	/* The thread may migrate before allocating, which only costs some
+	 * contention as the buffers can have more than one producer.
+	 */
+	unsigned int id = arch_curr_cpu()->id;
+
+	if (id != 0U) {
+		return &log_buffer_cpu[id - 1U];
+	}
+#endif
+	return &log_buffer;
+}
+
+/* Buffer a message allocated by z_log_msg_alloc() belongs to */
+static struct mpsc_pbuf_buffer *msg_buffer(struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFER
+	uintptr_t offset = (uintptr_t)msg - (uintptr_t)cpu_buf32;
+
+	if (offset < sizeof(cpu_buf32)) {
+		return &log_buffer_cpu[offset / sizeof(cpu_buf32[0])];
+	}
+#endif
+	ARG_UNUSED(msg);
+	return &log_buffer;
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -656,7 +715,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -678,7 +737,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -765,7 +824,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if (multi_buffer(len)) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -800,7 +859,7 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if (!multi_buffer(len)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -882,6 +941,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFER
+	for (int i = 0; i < CPU_BUFFERS; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(&log_buffer_cpu[i], &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
+#endif
+
 	return 0;
 }
 
@@ -893,7 +962,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFER
+	/* Sum of the maximums, which may not have been reached at once */
+	int err = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+
+	for (int i = 0; (err == 0) && (i < CPU_BUFFERS); i++) {
+		uint32_t cpu_max;
+
+		err = mpsc_pbuf_get_max_utilization(&log_buffer_cpu[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
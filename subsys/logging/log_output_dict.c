@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,6 +25,35 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+/* Copy to the output buffer, so that a message which fits in it reaches the
+ * output function in one call, on which backends rely to keep messages whole
+ * in log files or network packets.
+ */
+static void dict_write(const struct log_output *output, const uint8_t *data,
+		       size_t len)
+{
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		buffer_write(output->func, (uint8_t *)data, len,
+			     (void *)output->control_block->ctx);
+		return;
+	}
+
+	while (len != 0) {
+		size_t offset = output->control_block->offset;
+		size_t cpy_len = MIN(len, output->size - offset);
+
+		if (cpy_len == 0) {
+			log_output_flush(output);
+			continue;
+		}
+
+		memcpy(&output->buf[offset], data, cpy_len);
+		output->control_block->offset = offset + cpy_len;
+		data += cpy_len;
+		len -= cpy_len;
+	}
+}
+
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
 {
@@ -44,19 +74,18 @@ void log_dict_output_msg_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output->control_block->ctx);
+	dict_write(output, (uint8_t *)&output_hdr, sizeof(output_hdr));
 
 	size_t len;
 	uint8_t *data = log_msg_get_package(msg, &len);
 
 	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output->control_block->ctx);
+		dict_write(output, data, len);
 	}
 
 	data = log_msg_get_data(msg, &len);
 	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output->control_block->ctx);
+		dict_write(output, data, len);
 	}
 
 	log_output_flush(output);
@@ -69,6 +98,6 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output->control_block->ctx);
+	dict_write(output, (uint8_t *)&msg, sizeof(msg));
+	log_output_flush(output);
 }
@@ -116,6 +116,130 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connections with local and remote address and port all specified */
+static sys_slist_t conn_hash_exact[CONFIG_NET_CONN_HASH_SIZE];
+
+/* Other IP connections that are bound to a local port */
+static sys_slist_t conn_hash_port[CONFIG_NET_CONN_HASH_SIZE];
+
+/* IP connections without a local port */
+static sys_slist_t conn_hash_wildcard;
+
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash = (hash ^ val) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 15);
+}
+
+static uint32_t conn_hash_addr(uint32_t hash, uint8_t family,
+			       const uint8_t *addr)
+{
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					  sizeof(struct in_addr);
+	uint32_t val;
+
+	for (size_t i = 0; i < len; i += sizeof(val)) {
+		memcpy(&val, &addr[i], sizeof(val));
+		hash = conn_hash_mix(hash, val);
+	}
+
+	return hash;
+}
+
+/* Ports are in network byte order */
+static uint32_t conn_hash_exact_key(uint8_t proto, uint8_t family,
+				   const uint8_t *remote_addr,
+				   const uint8_t *local_addr,
+				   uint16_t remote_port, uint16_t local_port)
+{
+	uint32_t hash;
+
+	hash = conn_hash_mix(proto, ((uint32_t)remote_port << 16) | local_port);
+	hash = conn_hash_addr(hash, family, remote_addr);
+	hash = conn_hash_addr(hash, family, local_addr);
+
+	return hash % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static uint32_t conn_hash_port_key(uint8_t proto, uint16_t local_port)
+{
+	return conn_hash_mix(proto, local_port) % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static const uint8_t *conn_hash_sockaddr_raw(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return (const uint8_t *)&net_sin6(addr)->sin6_addr;
+	}
+
+	return (const uint8_t *)&net_sin(addr)->sin_addr;
+}
+
+static sys_slist_t *conn_hash_list_get(struct net_conn *conn)
+{
+	uint8_t all_spec = NET_CONN_RANK(0xff);
+
+	if (conn->family != AF_INET && conn->family != AF_INET6 &&
+	    conn->family != AF_UNSPEC) {
+		/* Packet and CAN sockets are only found from conn_used */
+		return NULL;
+	}
+
+	if ((conn->flags & all_spec) == all_spec &&
+	    conn->local_addr.sa_family == conn->family &&
+	    conn->remote_addr.sa_family == conn->family) {
+		return &conn_hash_exact[conn_hash_exact_key(
+				conn->proto, conn->family,
+				conn_hash_sockaddr_raw(&conn->remote_addr),
+				conn_hash_sockaddr_raw(&conn->local_addr),
+				net_sin(&conn->remote_addr)->sin_port,
+				net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		return &conn_hash_port[conn_hash_port_key(
+				conn->proto,
+				net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	return &conn_hash_wildcard;
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	conn->hash_list = conn_hash_list_get(conn);
+	if (conn->hash_list != NULL) {
+		sys_slist_prepend(conn->hash_list, &conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_del(struct net_conn *conn)
+{
+	if (conn->hash_list != NULL) {
+		sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+		conn->hash_list = NULL;
+	}
+}
+
+static void conn_hash_init(void)
+{
+	for (int i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash_exact[i]);
+		sys_slist_init(&conn_hash_port[i]);
+	}
+
+	sys_slist_init(&conn_hash_wildcard);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+#define conn_hash_init(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +265,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -452,6 +577,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_del(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -476,10 +602,19 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The remote end is part of the hash key */
+	conn_hash_del(conn);
+
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
+	conn_hash_add(conn);
+
+	k_mutex_unlock(&conn_lock);
+
 	return ret;
 }
 
@@ -634,6 +769,267 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_OK;
 }
 
+/* State of a single net_conn_input() lookup */
+struct conn_lookup {
+	struct net_pkt *pkt;
+	union net_ip_header *ip_hdr;
+	union net_proto_header *proto_hdr;
+	struct net_conn *best_match;
+	int16_t best_rank;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t proto;
+	uint8_t pkt_family;
+	bool is_mcast_pkt;
+	bool mcast_pkt_delivered;
+	bool raw_pkt_delivered;
+	bool raw_pkt_continue;
+};
+
+/* Check one candidate connection against the received packet. Returns
+ * NET_DROP if the packet must be dropped, NET_CONTINUE otherwise.
+ * Must be called with conn_lock held.
+ */
+static enum net_verdict conn_input_check(struct conn_lookup *lk,
+					 struct net_conn *conn)
+{
+	struct net_pkt *pkt = lk->pkt;
+	uint8_t pkt_family = lk->pkt_family;
+	uint8_t proto = lk->proto;
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (conn->context != NULL &&
+	    net_context_is_bound_to_iface(conn->context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		return NET_CONTINUE; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != AF_UNSPEC &&
+	    conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET)) {
+			/* If there are other listening connections than
+			 * AF_PACKET, the packet shall be also passed back to
+			 * net_conn_input() in upper layer processing in order to
+			 * re-check if there is any listening socket interested
+			 * in this packet.
+			 */
+			if (conn->family != AF_PACKET) {
+				lk->raw_pkt_continue = true;
+			}
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only)) {
+				return NET_CONTINUE;
+			}
+		} else {
+			return NET_CONTINUE; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		/* For packet socket data, the proto is set to ETH_P_ALL
+		 * or IPPROTO_RAW but the listener might have a specific
+		 * protocol set. This is ok and let the packet pass this
+		 * check in this case.
+		 */
+		if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
+			if (proto != ETH_P_ALL && proto != IPPROTO_RAW) {
+				return NET_CONTINUE; /* wrong protocol */
+			}
+		} else {
+			return NET_CONTINUE; /* wrong protocol */
+		}
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	uint8_t conn_family = conn->family;
+
+	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && conn_family == AF_PACKET) {
+		/* This code shall be only executed when one enters
+		 * the net_conn_input() from net_packet_socket() which
+		 * targets AF_PACKET sockets.
+		 *
+		 * All AF_PACKET connections will receive the packet if
+		 * their socket type and - in case of IPPROTO - protocol
+		 * also matches.
+		 */
+		if (proto == ETH_P_ALL) {
+			/* We shall continue with ETH_P_ALL to IPPROTO_RAW: */
+			lk->raw_pkt_continue = true;
+		}
+
+		/* With IPPROTO_RAW deliver only if protocol match: */
+		if ((proto == ETH_P_ALL && conn->proto != IPPROTO_RAW) ||
+		    conn->proto == proto) {
+			enum net_verdict ret = conn_raw_socket(pkt, conn, proto);
+
+			if (ret == NET_DROP) {
+				return NET_DROP;
+			} else if (ret == NET_OK) {
+				lk->raw_pkt_delivered = true;
+			}
+
+			return NET_CONTINUE; /* packet was consumed */
+		}
+	} else if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
+		   (conn_family == AF_INET || conn_family == AF_INET6 ||
+		    conn_family == AF_UNSPEC)) {
+		/* Is the candidate connection matching the packet's TCP/UDP
+		 * address and port?
+		 */
+		if (net_sin(&conn->remote_addr)->sin_port &&
+		    net_sin(&conn->remote_addr)->sin_port != lk->src_port) {
+			return NET_CONTINUE; /* wrong remote port */
+		}
+
+		if (net_sin(&conn->local_addr)->sin_port &&
+		    net_sin(&conn->local_addr)->sin_port != lk->dst_port) {
+			return NET_CONTINUE; /* wrong local port */
+		}
+
+		if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+		    !conn_addr_cmp(pkt, lk->ip_hdr, &conn->remote_addr, true)) {
+			return NET_CONTINUE; /* wrong remote address */
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+		    !conn_addr_cmp(pkt, lk->ip_hdr, &conn->local_addr, false)) {
+
+			/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+			 * has no IPV6_V6ONLY option set and if the local IPV6 address
+			 * is unspecified, then we could accept a connection from IPv4
+			 * address by mapping it to IPv6 address.
+			 */
+			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+				if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+				      !conn->v6only &&
+				      net_ipv6_is_addr_unspecified(
+					      &net_sin6(&conn->local_addr)->sin6_addr))) {
+					return NET_CONTINUE; /* wrong local address */
+				}
+			} else {
+				return NET_CONTINUE; /* wrong local address */
+			}
+
+			/* We might have a match for v4-to-v6 mapping,
+			 * continue with rank checking.
+			 */
+		}
+
+		if (lk->best_rank < NET_CONN_RANK(conn->flags)) {
+			struct net_if *pkt_iface = net_pkt_iface(pkt);
+			struct net_pkt *mcast_pkt;
+
+			if (!lk->is_mcast_pkt) {
+				lk->best_rank = NET_CONN_RANK(conn->flags);
+				lk->best_match = conn;
+
+				/* found a match - but maybe not yet the best */
+				return NET_CONTINUE;
+			}
+
+			/* If we have a multicast packet, and we found
+			 * a match, then deliver the packet immediately
+			 * to the handler. As there might be several
+			 * sockets interested about these, we need to
+			 * clone the received pkt.
+			 */
+
+			NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
+				conn->user_data);
+
+			mcast_pkt = net_pkt_clone(pkt, CLONE_TIMEOUT);
+			if (!mcast_pkt) {
+				return NET_DROP;
+			}
+
+			if (conn->cb(conn, mcast_pkt, lk->ip_hdr, lk->proto_hdr,
+				     conn->user_data) == NET_DROP) {
+				net_stats_update_per_proto_drop(pkt_iface, proto);
+				net_pkt_unref(mcast_pkt);
+			} else {
+				net_stats_update_per_proto_recv(pkt_iface, proto);
+			}
+
+			lk->mcast_pkt_delivered = true;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && conn_family == AF_CAN) {
+		lk->best_match = conn;
+	}
+
+	return NET_CONTINUE;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+static enum net_verdict conn_hash_list_input(struct conn_lookup *lk,
+					     sys_slist_t *list)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, hash_node) {
+		if (conn_input_check(lk, conn) == NET_DROP) {
+			return NET_DROP;
+		}
+	}
+
+	return NET_CONTINUE;
+}
+
+/* Only IPv4 and IPv6 packets are looked up from the hash tables.
+ * Must be called with conn_lock held.
+ */
+static enum net_verdict conn_hash_input(struct conn_lookup *lk)
+{
+	uint8_t *src, *dst;
+	uint32_t key;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && lk->pkt_family == AF_INET6) {
+		src = lk->ip_hdr->ipv6->src;
+		dst = lk->ip_hdr->ipv6->dst;
+	} else {
+		src = lk->ip_hdr->ipv4->src;
+		dst = lk->ip_hdr->ipv4->dst;
+	}
+
+	key = conn_hash_exact_key(lk->proto, lk->pkt_family, src, dst,
+				  lk->src_port, lk->dst_port);
+
+	if (conn_hash_list_input(lk, &conn_hash_exact[key]) == NET_DROP) {
+		return NET_DROP;
+	}
+
+	/* A fully specified connection has the highest possible rank,
+	 * so there is no need to look any further for unicast packets.
+	 */
+	if (lk->best_match != NULL && !lk->is_mcast_pkt) {
+		return NET_CONTINUE;
+	}
+
+	if (lk->dst_port != 0U) {
+		key = conn_hash_port_key(lk->proto, lk->dst_port);
+
+		if (conn_hash_list_input(lk, &conn_hash_port[key]) == NET_DROP) {
+			return NET_DROP;
+		}
+	}
+
+	return conn_hash_list_input(lk, &conn_hash_wildcard);
+}
+#else
+static inline enum net_verdict conn_hash_input(struct conn_lookup *lk)
+{
+	ARG_UNUSED(lk);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -681,13 +1077,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		ntohs(src_port), ntohs(dst_port), net_pkt_family(pkt));
 
 
-	struct net_conn *best_match = NULL;
-	int16_t best_rank = -1;
-	bool is_mcast_pkt = false;
-	bool mcast_pkt_delivered = false;
+	struct conn_lookup lk = {
+		.pkt = pkt,
+		.ip_hdr = ip_hdr,
+		.proto_hdr = proto_hdr,
+		.best_rank = -1,
+		.src_port = src_port,
+		.dst_port = dst_port,
+		.proto = proto,
+		.pkt_family = pkt_family,
+	};
 	bool is_bcast_pkt = false;
-	bool raw_pkt_delivered = false;
-	bool raw_pkt_continue = false;
+	struct net_conn *best_match;
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
@@ -698,186 +1099,34 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		 */
 		if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == AF_INET) {
 			if (net_ipv4_is_addr_mcast((struct in_addr *)ip_hdr->ipv4->dst)) {
-				is_mcast_pkt = true;
+				lk.is_mcast_pkt = true;
 			} else if (net_if_ipv4_is_addr_bcast(pkt_iface,
 							     (struct in_addr *)ip_hdr->ipv4->dst)) {
 				is_bcast_pkt = true;
 			}
 		} else if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == AF_INET6) {
-			is_mcast_pkt = net_ipv6_is_addr_mcast((struct in6_addr *)ip_hdr->ipv6->dst);
+			lk.is_mcast_pkt = net_ipv6_is_addr_mcast((struct in6_addr *)ip_hdr->ipv6->dst);
 		}
 	}
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (conn->context != NULL &&
-		    net_context_is_bound_to_iface(conn->context) &&
-		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
-			continue; /* wrong interface */
-		}
-
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != AF_UNSPEC &&
-		    conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET)) {
-				/* If there are other listening connections than
-				 * AF_PACKET, the packet shall be also passed back to
-				 * net_conn_input() in upper layer processing in order to
-				 * re-check if there is any listening socket interested
-				 * in this packet.
-				 */
-				if (conn->family != AF_PACKET) {
-					raw_pkt_continue = true;
-				}
-			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-				      !conn->v6only)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
-
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
-
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			/* For packet socket data, the proto is set to ETH_P_ALL
-			 * or IPPROTO_RAW but the listener might have a specific
-			 * protocol set. This is ok and let the packet pass this
-			 * check in this case.
-			 */
-			if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
-				if (proto != ETH_P_ALL && proto != IPPROTO_RAW) {
-					continue; /* wrong protocol */
-				}
-			} else {
-				continue; /* wrong protocol */
-			}
+	if (IS_ENABLED(CONFIG_NET_CONN_HASH) && IS_ENABLED(CONFIG_NET_IP) &&
+	    (pkt_family == AF_INET || pkt_family == AF_INET6)) {
+		if (conn_hash_input(&lk) == NET_DROP) {
+			k_mutex_unlock(&conn_lock);
+			goto drop;
 		}
-
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
-
-		if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && conn_family == AF_PACKET) {
-			/* This code shall be only executed when one enters
-			 * the net_conn_input() from net_packet_socket() which
-			 * targets AF_PACKET sockets.
-			 *
-			 * All AF_PACKET connections will receive the packet if
-			 * their socket type and - in case of IPPROTO - protocol
-			 * also matches.
-			 */
-			if (proto == ETH_P_ALL) {
-				/* We shall continue with ETH_P_ALL to IPPROTO_RAW: */
-				raw_pkt_continue = true;
-			}
-
-			/* With IPPROTO_RAW deliver only if protocol match: */
-			if ((proto == ETH_P_ALL && conn->proto != IPPROTO_RAW) ||
-			    conn->proto == proto) {
-				enum net_verdict ret = conn_raw_socket(pkt, conn, proto);
-
-				if (ret == NET_DROP) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				} else if (ret == NET_OK) {
-					raw_pkt_delivered = true;
-				}
-
-				continue; /* packet was consumed */
-			}
-		} else if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-			   (conn_family == AF_INET || conn_family == AF_INET6 ||
-			    conn_family == AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
-			}
-
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
-				struct net_pkt *mcast_pkt;
-
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
-				}
-
-				/* If we have a multicast packet, and we found
-				 * a match, then deliver the packet immediately
-				 * to the handler. As there might be several
-				 * sockets interested about these, we need to
-				 * clone the received pkt.
-				 */
-
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
-
-				mcast_pkt = net_pkt_clone(pkt, CLONE_TIMEOUT);
-				if (!mcast_pkt) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				}
-
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
-					net_stats_update_per_proto_drop(pkt_iface, proto);
-					net_pkt_unref(mcast_pkt);
-				} else {
-					net_stats_update_per_proto_recv(pkt_iface, proto);
-				}
-
-				mcast_pkt_delivered = true;
+	} else {
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+			if (conn_input_check(&lk, conn) == NET_DROP) {
+				k_mutex_unlock(&conn_lock);
+				goto drop;
 			}
-		} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && conn_family == AF_CAN) {
-			best_match = conn;
 		}
-	} /* loop end */
+	}
 
+	best_match = lk.best_match;
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -886,14 +1135,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	k_mutex_unlock(&conn_lock);
 
 	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
-		if (raw_pkt_continue) {
+		if (lk.raw_pkt_continue) {
 			/* When there is open connection different than
 			 * AF_PACKET this packet shall be also handled in
 			 * the upper net stack layers.
 			 */
 			return NET_CONTINUE;
 		}
-		if (raw_pkt_delivered) {
+		if (lk.raw_pkt_delivered) {
 			/* As one or more raw socket packets
 			 * have already been delivered in the loop above,
 			 * we shall not call the callback again here.
@@ -903,7 +1152,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	if (IS_ENABLED(CONFIG_NET_IP) && is_mcast_pkt && mcast_pkt_delivered) {
+	if (IS_ENABLED(CONFIG_NET_IP) && lk.is_mcast_pkt && lk.mcast_pkt_delivered) {
 		/* As one or more multicast packets
 		 * have already been delivered in the loop above,
 		 * we shall not call the callback again here.
@@ -929,7 +1178,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	NET_DBG("No match found.");
 
 	if (IS_ENABLED(CONFIG_NET_IP) && (pkt_family == AF_INET || pkt_family == AF_INET6) &&
-	    !(is_mcast_pkt || is_bcast_pkt)) {
+	    !(lk.is_mcast_pkt || is_bcast_pkt)) {
 		if (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP &&
 		    IS_ENABLED(CONFIG_NET_TCP_REJECT_CONN_WITH_RST)) {
 			net_tcp_reply_rst(pkt);
@@ -965,6 +1214,8 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+	conn_hash_init();
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
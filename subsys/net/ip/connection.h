@@ -82,6 +82,14 @@ struct net_conn {
 
 	/** Is v4-mapping-to-v6 enabled for this connection */
 	uint8_t v6only : 1;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node for the hashed lookup tables */
+	sys_snode_t hash_node;
+
+	/** Hash table list the connection is in, NULL if not hashed */
+	sys_slist_t *hash_list;
+#endif
 };
 
 /**
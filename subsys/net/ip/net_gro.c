@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic receive offload, merges consecutive TCP segments of the same
+ * connection waiting in an RX traffic class queue into one packet before
+ * the IP and TCP processing.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tc, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+#include "net_gro.h"
+#include "tcp_internal.h"
+
+/* IPv4 More Fragments flag and Fragment Offset mask */
+#define GRO_IPV4_FRAG_MASK 0x3fff
+
+enum gro_verdict {
+	/* Not a TCP segment, and not related to any held packet */
+	GRO_PASS,
+	/* The packet cannot be parsed, the held packets must be passed
+	 * up first so that no TCP segment is reordered.
+	 */
+	GRO_FLUSH_ALL,
+	/* TCP segment */
+	GRO_TCP,
+};
+
+struct gro_hdrs {
+	uint8_t *l2;
+	uint8_t *ip;
+	struct net_tcp_hdr *tcp;
+	uint16_t l2_len;
+	uint16_t ip_len;
+	uint16_t tcp_len;
+	uint16_t data_len;
+	uint8_t family;
+	bool can_merge;
+};
+
+static inline uint16_t gro_csum_add(uint16_t a, uint16_t b)
+{
+	uint32_t sum = (uint32_t)a + b;
+
+	return (uint16_t)((sum & 0xffff) + (sum >> 16));
+}
+
+/* One's complement sum of the pseudo header, in host byte order as
+ * returned by calc_chksum().
+ */
+static uint16_t gro_pseudo_sum(uint8_t family, const uint8_t *ip,
+			       uint16_t tcp_total)
+{
+	const uint8_t *addrs;
+	size_t len;
+
+	if (family == AF_INET) {
+		addrs = ((const struct net_ipv4_hdr *)ip)->src;
+		len = 2 * sizeof(struct in_addr);
+	} else {
+		addrs = ((const struct net_ipv6_hdr *)ip)->src;
+		len = 2 * sizeof(struct in6_addr);
+	}
+
+	return calc_chksum(gro_csum_add(tcp_total, IPPROTO_TCP), addrs, len);
+}
+
+/* Sum of the payload of a segment, assuming that its checksum is valid.
+ * If it is not, the checksum of the merged packet will not be valid
+ * either, so the TCP layer still drops corrupted data.
+ */
+static uint16_t gro_data_sum(const struct gro_hdrs *h)
+{
+	uint16_t sum;
+
+	sum = gro_pseudo_sum(h->family, h->ip, h->tcp_len + h->data_len);
+	sum = calc_chksum(sum, (const uint8_t *)h->tcp, h->tcp_len);
+
+	return (uint16_t)~sum;
+}
+
+static int gro_parse_l2(struct net_pkt *pkt, struct gro_hdrs *h)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct net_buf *buf = pkt->buffer;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr *eth = (struct net_eth_hdr *)buf->data;
+
+		if (buf->len < sizeof(*eth)) {
+			return GRO_FLUSH_ALL;
+		}
+
+		if (eth->type == htons(NET_ETH_PTYPE_IP)) {
+			h->family = AF_INET;
+		} else if (eth->type == htons(NET_ETH_PTYPE_IPV6)) {
+			h->family = AF_INET6;
+		} else if (eth->type == htons(NET_ETH_PTYPE_VLAN)) {
+			return GRO_FLUSH_ALL;
+		} else {
+			return GRO_PASS;
+		}
+
+		h->l2_len = sizeof(*eth);
+
+		return GRO_TCP;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		if (buf->len < 1) {
+			return GRO_FLUSH_ALL;
+		}
+
+		if ((buf->data[0] & 0xf0) == 0x40) {
+			h->family = AF_INET;
+		} else if ((buf->data[0] & 0xf0) == 0x60) {
+			h->family = AF_INET6;
+		} else {
+			return GRO_PASS;
+		}
+
+		h->l2_len = 0U;
+
+		return GRO_TCP;
+	}
+#endif
+
+	/* No flow is held for the interfaces of other types */
+	return GRO_PASS;
+}
+
+static int gro_parse(struct net_pkt *pkt, struct gro_hdrs *h)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t pkt_len = net_pkt_get_len(pkt);
+	size_t ip_total;
+	int ret;
+
+	ret = gro_parse_l2(pkt, h);
+	if (ret != GRO_TCP) {
+		return ret;
+	}
+
+	h->l2 = buf->data;
+	h->ip = buf->data + h->l2_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && h->family == AF_INET) {
+		struct net_ipv4_hdr *ipv4 = (struct net_ipv4_hdr *)h->ip;
+
+		if (buf->len < h->l2_len + sizeof(*ipv4) ||
+		    (ipv4->vhl & 0xf0) != 0x40) {
+			return GRO_FLUSH_ALL;
+		}
+
+		if (ipv4->proto != IPPROTO_TCP) {
+			return GRO_PASS;
+		}
+
+		/* No options and no fragments */
+		if (ipv4->vhl != 0x45 ||
+		    (sys_get_be16(ipv4->offset) & GRO_IPV4_FRAG_MASK) != 0U) {
+			return GRO_FLUSH_ALL;
+		}
+
+		h->ip_len = sizeof(*ipv4);
+		ip_total = ntohs(ipv4->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && h->family == AF_INET6) {
+		struct net_ipv6_hdr *ipv6 = (struct net_ipv6_hdr *)h->ip;
+
+		if (buf->len < h->l2_len + sizeof(*ipv6)) {
+			return GRO_FLUSH_ALL;
+		}
+
+		if (ipv6->nexthdr == IPPROTO_UDP ||
+		    ipv6->nexthdr == IPPROTO_ICMPV6) {
+			return GRO_PASS;
+		}
+
+		/* No extension headers */
+		if (ipv6->nexthdr != IPPROTO_TCP) {
+			return GRO_FLUSH_ALL;
+		}
+
+		h->ip_len = sizeof(*ipv6);
+		ip_total = sizeof(*ipv6) + ntohs(ipv6->len);
+	} else {
+		return GRO_PASS;
+	}
+
+	if (buf->len < h->l2_len + h->ip_len + sizeof(struct net_tcp_hdr)) {
+		return GRO_FLUSH_ALL;
+	}
+
+	h->tcp = (struct net_tcp_hdr *)(h->ip + h->ip_len);
+	h->tcp_len = (h->tcp->offset >> 4) * 4U;
+
+	/* Malformed, the IP or TCP layer drops it */
+	if (h->tcp_len < sizeof(struct net_tcp_hdr) ||
+	    ip_total < h->ip_len + h->tcp_len ||
+	    h->l2_len + ip_total > pkt_len) {
+		return GRO_PASS;
+	}
+
+	h->data_len = ip_total - h->ip_len - h->tcp_len;
+
+	/* Only plain data segments without link layer padding, and with all
+	 * the headers in the first fragment, are merged.
+	 */
+	h->can_merge = h->data_len > 0U &&
+		h->l2_len + ip_total == pkt_len &&
+		buf->len >= h->l2_len + h->ip_len + h->tcp_len &&
+		buf->ref == 1U &&
+		(h->tcp->flags & ACK) &&
+		(h->tcp->flags & ~(ACK | PSH)) == 0U;
+
+	return GRO_TCP;
+}
+
+static bool gro_same_flow(struct net_gro_flow *flow, struct net_pkt *pkt,
+			  const struct gro_hdrs *h)
+{
+	struct net_buf *buf = flow->pkt->buffer;
+	const uint8_t *ip = buf->data + flow->l2_len;
+	const struct net_tcp_hdr *tcp = (const struct net_tcp_hdr *)(ip + flow->ip_len);
+
+	if (net_pkt_iface(flow->pkt) != net_pkt_iface(pkt) ||
+	    flow->family != h->family ||
+	    tcp->src_port != h->tcp->src_port ||
+	    tcp->dst_port != h->tcp->dst_port) {
+		return false;
+	}
+
+	if (h->family == AF_INET) {
+		const struct net_ipv4_hdr *a = (const struct net_ipv4_hdr *)ip;
+		const struct net_ipv4_hdr *b = (const struct net_ipv4_hdr *)h->ip;
+
+		return memcmp(a->src, b->src, 2 * sizeof(struct in_addr)) == 0;
+	}
+
+	return memcmp(((const struct net_ipv6_hdr *)ip)->src,
+		      ((const struct net_ipv6_hdr *)h->ip)->src,
+		      2 * sizeof(struct in6_addr)) == 0;
+}
+
+/* Check that the segment continues the held packet, and that all the
+ * header fields the IP and TCP layers look at are the same.
+ */
+static bool gro_can_append(struct net_gro_flow *flow, const struct gro_hdrs *h)
+{
+	struct net_buf *buf = flow->pkt->buffer;
+	const uint8_t *ip = buf->data + flow->l2_len;
+	const struct net_tcp_hdr *tcp = (const struct net_tcp_hdr *)(ip + flow->ip_len);
+
+	if (!h->can_merge || flow->push ||
+	    flow->segments >= CONFIG_NET_GRO_MAX_SEGMENTS ||
+	    sys_get_be32(h->tcp->seq) != flow->next_seq ||
+	    /* The payload sums can only be added at even offsets */
+	    (flow->data_len & 1U) != 0U ||
+	    flow->ip_len + flow->tcp_len + flow->data_len + h->data_len > UINT16_MAX) {
+		return false;
+	}
+
+	if (flow->l2_len != h->l2_len ||
+	    memcmp(buf->data, h->l2, flow->l2_len) != 0) {
+		return false;
+	}
+
+	if (h->family == AF_INET) {
+		const struct net_ipv4_hdr *a = (const struct net_ipv4_hdr *)ip;
+		const struct net_ipv4_hdr *b = (const struct net_ipv4_hdr *)h->ip;
+
+		if (a->tos != b->tos || a->ttl != b->ttl) {
+			return false;
+		}
+	} else {
+		const struct net_ipv6_hdr *a = (const struct net_ipv6_hdr *)ip;
+		const struct net_ipv6_hdr *b = (const struct net_ipv6_hdr *)h->ip;
+
+		/* Version, traffic class and flow label */
+		if (memcmp(a, b, 4) != 0 || a->hop_limit != b->hop_limit) {
+			return false;
+		}
+	}
+
+	return flow->tcp_len == h->tcp_len &&
+		memcmp(tcp->ack, h->tcp->ack, sizeof(tcp->ack)) == 0 &&
+		memcmp(tcp->wnd, h->tcp->wnd, sizeof(tcp->wnd)) == 0 &&
+		memcmp(tcp->optdata, h->tcp->optdata,
+		       h->tcp_len - sizeof(struct net_tcp_hdr)) == 0;
+}
+
+static void gro_flow_start(struct net_gro_flow *flow, struct net_pkt *pkt,
+			   const struct gro_hdrs *h)
+{
+	flow->pkt = pkt;
+	flow->family = h->family;
+	flow->next_seq = sys_get_be32(h->tcp->seq) + h->data_len;
+	flow->l2_len = h->l2_len;
+	flow->ip_len = h->ip_len;
+	flow->tcp_len = h->tcp_len;
+	flow->data_len = h->data_len;
+	flow->segments = 1U;
+	flow->push = (h->tcp->flags & PSH) != 0U;
+}
+
+static void gro_flow_append(struct net_gro_flow *flow, struct net_pkt *pkt,
+			    const struct gro_hdrs *h)
+{
+	/* The headers are freed along with the segment below */
+	bool push = (h->tcp->flags & PSH) != 0U;
+	struct net_buf *frags;
+
+	if (flow->segments == 1U) {
+		struct gro_hdrs head = {
+			.family = h->family,
+			.ip = flow->pkt->buffer->data + flow->l2_len,
+			.tcp_len = flow->tcp_len,
+			.data_len = flow->data_len,
+		};
+
+		head.tcp = (struct net_tcp_hdr *)(head.ip + flow->ip_len);
+		flow->data_sum = gro_data_sum(&head);
+	}
+
+	flow->data_sum = gro_csum_add(flow->data_sum, gro_data_sum(h));
+
+	/* Keep only the payload of the segment */
+	net_buf_pull(pkt->buffer, h->l2_len + h->ip_len + h->tcp_len);
+	if (pkt->buffer->len == 0U) {
+		net_pkt_frag_del(pkt, NULL, pkt->buffer);
+	}
+
+	frags = pkt->buffer;
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	net_pkt_frag_add(flow->pkt, frags);
+
+	flow->next_seq += h->data_len;
+	flow->data_len += h->data_len;
+	flow->segments++;
+	flow->push = push;
+}
+
+/* Rewrite the headers of a merged packet for its new length */
+static void gro_flow_finalize(struct net_gro_flow *flow)
+{
+	uint8_t *ip = flow->pkt->buffer->data + flow->l2_len;
+	struct net_tcp_hdr *tcp = (struct net_tcp_hdr *)(ip + flow->ip_len);
+	uint16_t tcp_total = flow->tcp_len + flow->data_len;
+	uint16_t sum;
+
+	if (flow->family == AF_INET) {
+		struct net_ipv4_hdr *ipv4 = (struct net_ipv4_hdr *)ip;
+
+		ipv4->len = htons(flow->ip_len + tcp_total);
+		ipv4->chksum = 0U;
+
+		sum = calc_chksum(0U, ip, flow->ip_len);
+		sum = (sum == 0U) ? 0xffff : htons(sum);
+		ipv4->chksum = ~sum;
+
+		sum = gro_pseudo_sum(AF_INET, ip, tcp_total);
+	} else {
+		((struct net_ipv6_hdr *)ip)->len = htons(tcp_total);
+
+		sum = gro_pseudo_sum(AF_INET6, ip, tcp_total);
+	}
+
+	if (flow->push) {
+		tcp->flags |= PSH;
+	}
+
+	tcp->chksum = 0U;
+	sum = calc_chksum(sum, (uint8_t *)tcp, flow->tcp_len);
+	sum = gro_csum_add(sum, flow->data_sum);
+	tcp->chksum = htons((uint16_t)~sum);
+}
+
+static void gro_flow_flush(struct net_gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	if (flow->segments > 1U) {
+		gro_flow_finalize(flow);
+
+		NET_DBG("pkt %p: %u segments, %u bytes", pkt, flow->segments,
+			flow->data_len);
+
+		net_stats_update_gro_merged(net_pkt_iface(pkt),
+					    flow->segments - 1U);
+		net_stats_update_gro_flushed(net_pkt_iface(pkt));
+	}
+
+	flow->pkt = NULL;
+
+	net_process_rx_packet(pkt);
+}
+
+void net_gro_flush(struct net_gro *gro)
+{
+	ARRAY_FOR_EACH_PTR(gro->flows, flow) {
+		gro_flow_flush(flow);
+	}
+}
+
+void net_gro_receive(struct net_gro *gro, struct net_pkt *pkt)
+{
+	struct net_gro_flow *free_flow = NULL;
+	struct gro_hdrs h;
+
+	switch (gro_parse(pkt, &h)) {
+	case GRO_PASS:
+		net_process_rx_packet(pkt);
+		return;
+
+	case GRO_FLUSH_ALL:
+		net_gro_flush(gro);
+		net_process_rx_packet(pkt);
+		return;
+
+	default:
+		break;
+	}
+
+	ARRAY_FOR_EACH_PTR(gro->flows, flow) {
+		if (flow->pkt == NULL) {
+			if (free_flow == NULL) {
+				free_flow = flow;
+			}
+
+			continue;
+		}
+
+		if (!gro_same_flow(flow, pkt, &h)) {
+			continue;
+		}
+
+		if (gro_can_append(flow, &h)) {
+			gro_flow_append(flow, pkt, &h);
+			return;
+		}
+
+		/* Keep the order of the segments of the connection */
+		gro_flow_flush(flow);
+		free_flow = flow;
+		break;
+	}
+
+	if (!h.can_merge) {
+		net_process_rx_packet(pkt);
+		return;
+	}
+
+	if (free_flow == NULL) {
+		free_flow = &gro->flows[0];
+		gro_flow_flush(free_flow);
+	}
+
+	gro_flow_start(free_flow, pkt, &h);
+}
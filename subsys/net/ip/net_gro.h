@@ -0,0 +1,86 @@
+/** @file
+ * @brief Generic receive offload
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GRO_H
+#define __NET_GRO_H
+
+#include <zephyr/types.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Max number of packets fed to the GRO before it is flushed, so that a
+ * busy RX queue cannot hold back packets indefinitely.
+ */
+#define NET_GRO_BUDGET (CONFIG_NET_GRO_MAX_FLOWS * CONFIG_NET_GRO_MAX_SEGMENTS)
+
+/* TCP connection for which a merged packet is being built */
+struct net_gro_flow {
+	/* First segment, the payload of the next ones is chained to it */
+	struct net_pkt *pkt;
+
+	/* Sequence number expected in the next segment */
+	uint32_t next_seq;
+
+	/* Address family of the connection */
+	uint8_t family;
+
+	/* Length of the link, IP and TCP headers */
+	uint16_t l2_len;
+	uint16_t ip_len;
+	uint16_t tcp_len;
+
+	/* Length of the merged TCP payload */
+	uint16_t data_len;
+
+	/* One's complement sum of the merged payload, derived from the
+	 * checksums of the segments.
+	 */
+	uint16_t data_sum;
+
+	/* Number of merged segments */
+	uint8_t segments;
+
+	/* A segment with the PSH flag was merged */
+	bool push;
+};
+
+/* GRO state of an RX traffic class thread */
+struct net_gro {
+	struct net_gro_flow flows[CONFIG_NET_GRO_MAX_FLOWS];
+};
+
+/**
+ * @brief Feed a received packet to the GRO.
+ *
+ * The packet is either held to be merged with the next segments of the
+ * same TCP connection, or passed to net_process_rx_packet().
+ *
+ * @param gro GRO state
+ * @param pkt Packet as received from the network driver
+ */
+void net_gro_receive(struct net_gro *gro, struct net_pkt *pkt);
+
+/**
+ * @brief Pass all the held packets to net_process_rx_packet().
+ *
+ * @param gro GRO state
+ */
+void net_gro_flush(struct net_gro *gro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GRO_H */
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic segmentation offload, cuts the large packets built by TCP into
+ * MSS sized segments just before they are given to the driver.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_if, CONFIG_NET_IF_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "net_gso.h"
+#include "tcp_internal.h"
+
+#define GSO_BUF_TIMEOUT K_MSEC(100)
+
+static void gso_copy_attributes(struct net_pkt *pkt, struct net_pkt *seg)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ip_dscp(seg, net_pkt_ip_dscp(pkt));
+	net_pkt_set_ip_ecn(seg, net_pkt_ip_ecn(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+static int gso_finalize(struct net_pkt *seg)
+{
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		return net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
+
+/* Build the segment carrying len bytes of payload from offset, with the
+ * headers of the GSO packet.
+ */
+static struct net_pkt *gso_segment(struct net_pkt *pkt, size_t ip_len,
+				   size_t hdr_len, size_t offset, size_t len,
+				   uint32_t seq, uint8_t flags)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, GSO_BUF_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	gso_copy_attributes(pkt, seg);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto fail;
+	}
+
+	sys_put_be32(seq, tcp_hdr->seq);
+	tcp_hdr->flags = flags;
+
+	if (net_pkt_set_data(seg, &tcp_access) < 0 || gso_finalize(seg) < 0) {
+		goto fail;
+	}
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_len, hdr_len;
+	size_t data_len, offset;
+	struct net_pkt *seg;
+	uint8_t flags;
+	uint32_t seq;
+	int sent = 0;
+	int ret = 0;
+
+	if (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO) {
+		return net_if_l2(iface)->send(iface, pkt);
+	}
+
+	ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (offset = 0; offset < data_len; offset += mss) {
+		size_t len = MIN(mss, data_len - offset);
+		bool last = (offset + len == data_len);
+
+		/* Only the last segment ends the pushed data */
+		seg = gso_segment(pkt, ip_len, hdr_len, offset, len,
+				  seq + offset,
+				  last ? flags : (flags & ~(PSH | FIN)));
+		if (!seg) {
+			ret = -ENOBUFS;
+			break;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		sent += ret;
+	}
+
+	if (ret < 0) {
+		NET_DBG("iface %p GSO pkt %p stopped at %zu/%zu (%d)",
+			iface, pkt, offset, data_len, ret);
+
+		/* Let the caller drop the packet if nothing was sent,
+		 * otherwise the rest of the data is recovered by the TCP
+		 * retransmissions.
+		 */
+		if (sent == 0) {
+			return ret;
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
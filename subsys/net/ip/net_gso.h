@@ -0,0 +1,42 @@
+/** @file
+ * @brief Generic segmentation offload
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GSO_H
+#define __NET_GSO_H
+
+#include <zephyr/types.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Send a GSO packet with the L2 of the interface.
+ *
+ * The packet is given as is to drivers with the ETHERNET_HW_TSO capability.
+ * Otherwise it is cut into TCP segments of net_pkt_gso_size() bytes of
+ * payload, which are sent one by one.
+ *
+ * @param iface Network interface
+ * @param pkt GSO packet, consumed on success
+ *
+ * @return Number of bytes sent, or a negative errno if nothing was sent.
+ */
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GSO_H */
@@ -36,6 +36,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv6.h"
 
 #include "net_stats.h"
+#include "net_gso.h"
 
 #define REACHABLE_TIME (MSEC_PER_SEC * 30) /* in ms */
 /*
@@ -260,7 +261,13 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U) {
+			status = net_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
+
 		net_if_tx_unlock(iface);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS) ||
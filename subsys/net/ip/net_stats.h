@@ -275,6 +275,22 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+static inline void net_stats_update_gro_merged(struct net_if *iface,
+					       uint32_t segments)
+{
+	UPDATE_STAT(iface, stats.gro.merged += segments);
+}
+
+static inline void net_stats_update_gro_flushed(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.gro.flushed++);
+}
+#else
+#define net_stats_update_gro_merged(iface, segments)
+#define net_stats_update_gro_flushed(iface)
+#endif /* CONFIG_NET_STATISTICS_GRO */
+
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
 						   enum net_ip_protocol proto)
 {
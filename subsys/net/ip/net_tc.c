@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "net_gro.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
@@ -38,6 +39,10 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 
 #if NET_TC_RX_COUNT > 0
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+
+#if defined(CONFIG_NET_GRO)
+static struct net_gro rx_gro[NET_TC_RX_COUNT];
+#endif
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -242,19 +247,39 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(void *p1, void *p2, void *p3)
 {
-	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
 	struct k_fifo *fifo = p1;
 	struct net_pkt *pkt;
 
+#if defined(CONFIG_NET_GRO)
+	struct net_gro *gro = p2;
+	int budget;
+#else
+	ARG_UNUSED(p2);
+#endif
+
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
 		if (pkt == NULL) {
 			continue;
 		}
 
+#if defined(CONFIG_NET_GRO)
+		/* Merge the segments already waiting in the queue, and pass
+		 * everything up when it runs empty or the budget is used.
+		 */
+		budget = NET_GRO_BUDGET;
+
+		do {
+			net_gro_receive(gro, pkt);
+		} while (--budget > 0 &&
+			 (pkt = k_fifo_get(fifo, K_NO_WAIT)) != NULL);
+
+		net_gro_flush(gro);
+#else
 		net_process_rx_packet(pkt);
+#endif
 	}
 }
 #endif
@@ -379,7 +404,9 @@ void net_tc_rx_init(void)
 		tid = k_thread_create(&rx_classes[i].handler, rx_stack[i],
 				      K_KERNEL_STACK_SIZEOF(rx_stack[i]),
 				      tc_rx_handler,
-				      &rx_classes[i].fifo, NULL, NULL,
+				      &rx_classes[i].fifo,
+				      COND_CODE_1(CONFIG_NET_GRO, (&rx_gro[i]), (NULL)),
+				      NULL,
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
@@ -32,7 +32,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -127,32 +127,14 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
-	struct net_nbr *ret = NULL;
-	int i;
+	struct net_nbr *nbr;
 
 	NET_ASSERT(route);
 
-	net_ipv6_nbr_lock();
-
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
-		struct net_nbr *nbr = get_nbr(i);
-
-		if (!nbr->ref) {
-			continue;
-		}
-
-		if (nbr->data == (uint8_t *)route) {
-			if (!nbr->ref) {
-				break;
-			}
-
-			ret = nbr;
-			break;
-		}
-	}
+	/* The route entry is the data of its neighbor entry in the pool */
+	nbr = CONTAINER_OF((uint8_t *)route, struct net_nbr, __nbr[0]);
 
-	net_ipv6_nbr_unlock();
-	return ret;
+	return nbr->ref ? nbr : NULL;
 }
 
 void net_routes_print(void)
@@ -263,19 +245,79 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Result of the last lookups, flushed whenever the routing table changes */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  const struct in6_addr *dst)
+{
+	uint32_t hash = POINTER_TO_UINT(iface);
+
+	for (int i = 0; i < ARRAY_SIZE(dst->s6_addr32); i++) {
+		hash = (hash ^ UNALIGNED_GET(&dst->s6_addr32[i])) * 0x9e3779b1U;
+		hash ^= hash >> 15;
+	}
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       const struct in6_addr *dst)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (entry->route != NULL && entry->iface == iface &&
+	    net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return entry->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_put(struct net_if *iface, const struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+}
+
+static void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_get(...) NULL
+#define route_cache_put(...)
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+#define route_find net_route_lpm_lookup
+#else
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +340,25 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_cache_get(iface, dst);
+	if (!found) {
+		found = route_find(iface, dst);
+		if (found) {
+			route_cache_put(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -308,6 +369,35 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 	return found;
 }
 
+/* Route with exactly this prefix, unlike net_route_lookup() which also
+ * returns the routes with a shorter prefix covering addr.
+ */
+static struct net_route_entry *route_get(struct net_if *iface,
+					 struct in6_addr *addr,
+					 uint8_t prefix_len)
+{
+	struct net_route_entry *route;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+
+		if (!nbr->ref || nbr->iface != iface) {
+			continue;
+		}
+
+		route = net_route_data(nbr);
+
+		if (route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
 static inline bool route_preference_is_lower(uint8_t old, uint8_t new)
 {
 	if (new == NET_ROUTE_PREFERENCE_RESERVED || (new & 0xfc) != 0) {
@@ -361,7 +451,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	route = route_get(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -393,9 +483,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
-
-		sys_slist_find_and_remove(&routes, last);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -444,7 +532,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -455,6 +543,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	if (net_route_lpm_add(route) < 0) {
+		NET_ERR("Cannot index route to %s", net_sprint_ipv6_addr(addr));
+		net_route_del(route);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
+	route_cache_flush();
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -586,7 +685,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -594,6 +695,12 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_lpm_del(route);
+#endif
+
+	route_cache_flush();
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
@@ -1132,5 +1239,10 @@ void net_route_init(void)
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_lpm_init();
+#endif
+	route_cache_flush();
+
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
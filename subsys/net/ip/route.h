@@ -15,6 +15,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
@@ -47,7 +48,14 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Node in the list of routes with the same prefix in the longest
+	 * prefix match index.
+	 */
+	sys_snode_t lpm_node;
+#endif
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
@@ -328,6 +336,15 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* Longest prefix match index of the routing table, used by route.c */
+void net_route_lpm_init(void);
+int net_route_lpm_add(struct net_route_entry *route);
+void net_route_lpm_del(struct net_route_entry *route);
+struct net_route_entry *net_route_lpm_lookup(struct net_if *iface,
+					     const struct in6_addr *dst);
+#endif /* CONFIG_NET_ROUTE_LPM */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
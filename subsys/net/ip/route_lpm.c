@@ -0,0 +1,246 @@
+/** @file
+ * @brief Longest prefix match index of the routing table.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* The routes are indexed by a path compressed binary trie. Each node
+ * holds a prefix, and the routes having exactly that prefix, possibly on
+ * different interfaces. Nodes without routes are only kept where two
+ * branches split, so a lookup visits at most one node per distinct prefix
+ * length on the path to the destination instead of every route.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+#include "route.h"
+
+/* A trie with N prefixes has at most N - 1 branching nodes */
+#define LPM_MAX_NODES (2 * CONFIG_NET_MAX_ROUTES)
+
+struct route_lpm_node {
+	struct route_lpm_node *child[2];
+
+	/* Routes having exactly this prefix */
+	sys_slist_t routes;
+
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+	bool in_use;
+};
+
+static struct route_lpm_node lpm_nodes[LPM_MAX_NODES];
+static struct route_lpm_node *lpm_root;
+
+static inline uint8_t addr_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7U - (pos % 8U))) & 1U;
+}
+
+/* Number of leading bits that are the same in both addresses, up to max */
+static uint8_t common_prefix_len(const struct in6_addr *a,
+				 const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(a->s6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct route_lpm_node *node_alloc(const struct in6_addr *prefix,
+					 uint8_t prefix_len)
+{
+	ARRAY_FOR_EACH_PTR(lpm_nodes, node) {
+		if (node->in_use) {
+			continue;
+		}
+
+		node->in_use = true;
+		node->child[0] = NULL;
+		node->child[1] = NULL;
+		sys_slist_init(&node->routes);
+		net_ipaddr_copy(&node->prefix, prefix);
+		node->prefix_len = prefix_len;
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static inline void node_free(struct route_lpm_node *node)
+{
+	node->in_use = false;
+}
+
+void net_route_lpm_init(void)
+{
+	memset(lpm_nodes, 0, sizeof(lpm_nodes));
+	lpm_root = NULL;
+}
+
+int net_route_lpm_add(struct net_route_entry *route)
+{
+	struct route_lpm_node **link = &lpm_root;
+	const struct in6_addr *prefix = &route->addr;
+	uint8_t prefix_len = route->prefix_len;
+	struct route_lpm_node *node, *new_node, *branch;
+	uint8_t common;
+
+	if (prefix_len > 128U) {
+		/* Such a route never matches, no need to index it */
+		return 0;
+	}
+
+	while ((node = *link) != NULL) {
+		common = common_prefix_len(&node->prefix, prefix,
+					   MIN(node->prefix_len, prefix_len));
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			sys_slist_append(&node->routes, &route->lpm_node);
+			return 0;
+		}
+
+		link = &node->child[addr_bit(prefix, node->prefix_len)];
+	}
+
+	new_node = node_alloc(prefix, prefix_len);
+	if (new_node == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&new_node->routes, &route->lpm_node);
+
+	if (node == NULL) {
+		*link = new_node;
+		return 0;
+	}
+
+	if (common == prefix_len) {
+		/* The new prefix covers the one of the node */
+		new_node->child[addr_bit(&node->prefix, prefix_len)] = node;
+		*link = new_node;
+		return 0;
+	}
+
+	/* Both prefixes differ after common bits, branch there */
+	branch = node_alloc(prefix, common);
+	if (branch == NULL) {
+		node_free(new_node);
+		return -ENOMEM;
+	}
+
+	branch->child[addr_bit(prefix, common)] = new_node;
+	branch->child[addr_bit(&node->prefix, common)] = node;
+	*link = branch;
+
+	return 0;
+}
+
+void net_route_lpm_del(struct net_route_entry *route)
+{
+	struct route_lpm_node **parent_link = NULL;
+	struct route_lpm_node **link = &lpm_root;
+	struct route_lpm_node *node, *parent;
+
+	while ((node = *link) != NULL) {
+		if (node->prefix_len > route->prefix_len) {
+			return;
+		}
+
+		if (node->prefix_len == route->prefix_len) {
+			break;
+		}
+
+		parent_link = link;
+		link = &node->child[addr_bit(&route->addr, node->prefix_len)];
+	}
+
+	if (node == NULL ||
+	    !sys_slist_find_and_remove(&node->routes, &route->lpm_node) ||
+	    !sys_slist_is_empty(&node->routes)) {
+		return;
+	}
+
+	if (node->child[0] != NULL && node->child[1] != NULL) {
+		/* Still needed to branch */
+		return;
+	}
+
+	*link = node->child[0] != NULL ? node->child[0] : node->child[1];
+	node_free(node);
+
+	if (*link != NULL || parent_link == NULL) {
+		return;
+	}
+
+	/* The parent may now be a branch node with a single child */
+	parent = *parent_link;
+	if (sys_slist_is_empty(&parent->routes)) {
+		*parent_link = parent->child[0] != NULL ? parent->child[0]
+							: parent->child[1];
+		node_free(parent);
+	}
+}
+
+static struct net_route_entry *node_route(struct route_lpm_node *node,
+					  struct net_if *iface)
+{
+	struct net_route_entry *route;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, lpm_node) {
+		if (iface == NULL || route->iface == iface) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+struct net_route_entry *net_route_lpm_lookup(struct net_if *iface,
+					     const struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+	struct route_lpm_node *node = lpm_root;
+	struct net_route_entry *route;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		route = node_route(node, iface);
+		if (route != NULL) {
+			found = route;
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/hash_function.h>
 
 #if defined(CONFIG_NET_TCP_ISN_RFC6528)
 #include <psa/crypto.h>
@@ -64,12 +65,13 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
+/* Connections whose endpoints are set, hashed by the endpoints. The
+ * tcp_conns list above is only used for iterating all the connections.
+ */
+static sys_slist_t tcp_conn_hash[CONFIG_NET_TCP_CONN_HASH_SIZE];
+
 static K_MUTEX_DEFINE(tcp_lock);
 
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
@@ -239,6 +241,41 @@ static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 	return ret;
 }
 
+static sys_slist_t *tcp_conn_hash_bucket(union tcp_endpoint *local,
+					 union tcp_endpoint *remote)
+{
+	uint8_t key[2 * sizeof(union tcp_endpoint)];
+	size_t len = tcp_endpoint_len(local->sa.sa_family);
+
+	memcpy(key, local, len);
+	memcpy(&key[len], remote, len);
+
+	return &tcp_conn_hash[sys_hash32_murmur3((const char *)key, 2 * len) %
+			      CONFIG_NET_TCP_CONN_HASH_SIZE];
+}
+
+/* Must be called with tcp_lock held */
+static void tcp_conn_hash_remove(struct tcp *conn)
+{
+	if (conn->hash_bucket != NULL) {
+		sys_slist_find_and_remove(conn->hash_bucket, &conn->hash_next);
+		conn->hash_bucket = NULL;
+	}
+}
+
+/* Must be called whenever the connection endpoints are set */
+static void tcp_conn_hash_update(struct tcp *conn)
+{
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	tcp_conn_hash_remove(conn);
+
+	conn->hash_bucket = tcp_conn_hash_bucket(&conn->src, &conn->dst);
+	sys_slist_append(conn->hash_bucket, &conn->hash_next);
+
+	k_mutex_unlock(&tcp_lock);
+}
+
 int net_tcp_endpoint_copy(struct net_context *ctx,
 			  struct sockaddr *local,
 			  struct sockaddr *peer,
@@ -513,29 +550,100 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.on_ack = tcp_new_reno_pkts_acked,
+	.on_dup_ack = tcp_new_reno_dup_ack,
+	.on_loss = tcp_new_reno_fast_retransmit,
+	.on_rto = tcp_new_reno_timeout,
+};
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_ca_cubic,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_ca_cubic)
+#else
+#define TCP_CA_DEFAULT (&tcp_ca_new_reno)
+#endif
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca_ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca_ops->on_loss(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca_ops->on_rto(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca_ops->on_dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca_ops->on_ack(conn, acked_len);
+}
+
+static void tcp_ca_ops_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca_ops = from->ca_ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	size_t name_len = strnlen(value, len);
+
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		const struct tcp_ca_ops *ops = tcp_ca_algorithms[i];
+
+		if (name_len != strlen(ops->name) ||
+		    memcmp(value, ops->name, name_len) != 0) {
+			continue;
+		}
+
+		if (conn->ca_ops != ops) {
+			conn->ca_ops = ops;
+
+			/* Restart from the initial window if the previous
+			 * algorithm was already running.
+			 */
+			if (conn->state == TCP_ESTABLISHED ||
+			    conn->state == TCP_CLOSE_WAIT) {
+				tcp_ca_init(conn);
+			}
+		}
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca_ops->name) + 1;
+
+	if (len == NULL) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->ca_ops->name, *len);
+
+	return 0;
 }
 #else
 
@@ -549,6 +657,10 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+#define tcp_ca_ops_copy(...)
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -813,6 +925,7 @@ static void tcp_conn_release(struct k_work *work)
 
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
+	tcp_conn_hash_remove(conn);
 	k_mutex_unlock(&tcp_lock);
 
 	k_mem_slab_free(&tcp_conns_slab, (void *)conn);
@@ -1094,7 +1207,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1104,8 +1217,20 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS, window scale and SACK permitted are only sent in a SYN, so
+	 * keep them when a later segment carries other options (SACK blocks).
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+		recv_options->sack_perm_found = false;
+#endif
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_count = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1154,6 +1279,34 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 0; i < (opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE &&
+					i < NET_TCP_SACK_MAX_BLOCKS; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].end =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+				recv_options->sack_count = i + 1;
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1345,7 +1498,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1359,11 +1512,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = (sizeof(struct tcphdr) + opts_len) / sizeof(uint32_t);
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -1544,17 +1693,106 @@ err:
 	tcp_pkt_unref(rst);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+/* The SACK options are padded with two NOPs to keep them 32 bit aligned */
+#define TCP_SACK_PERM_OPT_LEN (2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE)
+#define TCP_SACK_OPT_LEN (2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE)
+
+/* Report the out of order data held in the receive queue */
+static bool tcp_sack_recv_block(struct tcp *conn, struct tcp_sack_block *block)
+{
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT || !conn->queue_recv_data ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return false;
+	}
+
+	block->start = tcp_get_seq(conn->queue_recv_data->buffer);
+	block->end = block->start + net_pkt_get_len(conn->queue_recv_data);
+
+	return net_tcp_seq_cmp(block->start, conn->ack) > 0;
+}
+
+static size_t tcp_sack_opt_len(struct tcp *conn, uint8_t flags,
+			       struct tcp_sack_block *block)
+{
+	if (flags & SYN) {
+		/* SACK is always offered in our SYN, but a SYN-ACK may only
+		 * carry it if the peer offered it first.
+		 */
+		if (!(flags & ACK) || conn->sack_permitted) {
+			return TCP_SACK_PERM_OPT_LEN;
+		}
+
+		return 0;
+	}
+
+	if ((flags & ACK) && !(flags & RST) && conn->sack_permitted &&
+	    tcp_sack_recv_block(conn, block)) {
+		return TCP_SACK_OPT_LEN;
+	}
+
+	return 0;
+}
+
+static int tcp_sack_opt_add(struct net_pkt *pkt, size_t opt_len,
+			    const struct tcp_sack_block *block)
+{
+	uint8_t opt[TCP_SACK_OPT_LEN] = { NET_TCP_NOP_OPT, NET_TCP_NOP_OPT };
+
+	if (opt_len == TCP_SACK_PERM_OPT_LEN) {
+		opt[2] = NET_TCP_SACK_PERM_OPT;
+		opt[3] = NET_TCP_SACK_PERM_SIZE;
+	} else {
+		opt[2] = NET_TCP_SACK_OPT;
+		opt[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(block->start), (uint32_t *)&opt[4]);
+		UNALIGNED_PUT(htonl(block->end), (uint32_t *)&opt[8]);
+	}
+
+	return net_pkt_write(pkt, opt, opt_len);
+}
+
+/* Called when the peer's SYN or SYN-ACK has been parsed */
+static void tcp_sack_negotiate(struct tcp *conn)
+{
+	conn->sack_permitted = conn->recv_options.sack_perm_found;
+}
+#else
+static inline size_t tcp_sack_opt_len(struct tcp *conn, uint8_t flags,
+				      struct tcp_sack_block *block)
+{
+	return 0;
+}
+
+static inline int tcp_sack_opt_add(struct net_pkt *pkt, size_t opt_len,
+				   const struct tcp_sack_block *block)
+{
+	return 0;
+}
+
+static inline void tcp_sack_negotiate(struct tcp *conn) { }
+#endif /* CONFIG_NET_TCP_SACK */
+
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
 	size_t alloc_len = sizeof(struct tcphdr);
+	struct tcp_sack_block sack_block;
+	size_t sack_opt_len;
+	size_t opts_len = 0;
+	size_t data_len = 0;
 	struct net_pkt *pkt;
 	int ret = 0;
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += NET_TCP_MSS_SIZE;
 	}
 
+	sack_opt_len = tcp_sack_opt_len(conn, flags, &sack_block);
+	opts_len += sack_opt_len;
+	alloc_len += opts_len;
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1562,18 +1800,25 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		data_len = net_pkt_get_len(data);
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
 	}
 
+	if (data_len > conn_mss(conn)) {
+		/* Segmented just before the driver, or by the driver itself */
+		net_pkt_set_gso_size(pkt, conn_mss(conn));
+	}
+
 	ret = ip_header_add(conn, pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1587,6 +1832,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (sack_opt_len) {
+		ret = tcp_sack_opt_add(pkt, sack_opt_len, &sack_block);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1742,13 +1995,89 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+/* Max amount of data sent as one packet */
+static int tcp_send_len_max(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_if_l2(conn->iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return conn_mss(conn) * CONFIG_NET_TCP_GSO_MAX_SEGMENTS;
+	}
+#endif
+
+	return conn_mss(conn);
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Unlike tcp_pkt_alloc(), the length is not limited to the MTU. Do not
+ * wait for the buffers, the caller falls back to a single segment.
+ */
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, int len)
+{
+	struct net_pkt *pkt;
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Send len bytes of the send_data starting at offset as one segment, or
+ * as one GSO packet if len is larger than the MSS.
+ */
+static int tcp_send_segment(struct tcp *conn, int offset, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+#if defined(CONFIG_NET_TCP_GSO)
+	if (len > conn_mss(conn)) {
+		pkt = tcp_gso_pkt_alloc(conn, len);
+		if (!pkt) {
+			NET_DBG("conn: %p no buffers for GSO, len=%d", conn, len);
+			return -ENOBUFS;
+		}
+	} else
+#endif
+	{
+		pkt = tcp_pkt_alloc(conn, len);
+		if (!pkt) {
+			NET_ERR("conn: %p packet allocation failed, len=%d",
+				conn, len);
+			return -ENOBUFS;
+		}
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
-	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), tcp_send_len_max(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1759,45 +2088,316 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+#if defined(CONFIG_NET_TCP_GSO)
+	/* With Nagle's algorithm a segment shorter than the MSS is only sent
+	 * when no data is in flight, which is not the case for the last
+	 * segment of a GSO packet. Leave it to tcp_send_queued_data().
+	 */
+	if (!conn->tcp_nodelay && conn->data_mode != TCP_DATA_MODE_RESEND &&
+	    len > conn_mss(conn)) {
+		len -= len % conn_mss(conn);
 	}
+#endif
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
+	if (ret == -ENOBUFS && len > conn_mss(conn)) {
+		len = conn_mss(conn);
+		ret = tcp_send_segment(conn, conn->unacked_len, len);
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
+		for (int sent = 0; sent < len; sent += conn_mss(conn)) {
+			if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+				net_stats_update_tcp_seg_rexmit(conn->iface);
+			} else {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
+		}
+
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
-			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
 		}
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
-
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+static void tcp_sack_board_del(struct tcp *conn, int idx)
+{
+	conn->sack_board_len--;
+	memmove(&conn->sack_board[idx], &conn->sack_board[idx + 1],
+		(conn->sack_board_len - idx) * sizeof(conn->sack_board[0]));
+}
+
+static void tcp_sack_board_add(struct tcp *conn, struct tcp_sack_block blk)
+{
+	struct tcp_sack_block *board = conn->sack_board;
+	int i = 0;
+
+	/* Absorb the blocks overlapping or adjacent to the new one */
+	while (i < conn->sack_board_len) {
+		if (net_tcp_seq_cmp(board[i].start, blk.end) <= 0 &&
+		    net_tcp_seq_cmp(blk.start, board[i].end) <= 0) {
+			if (net_tcp_seq_cmp(board[i].start, blk.start) < 0) {
+				blk.start = board[i].start;
+			}
+
+			if (net_tcp_seq_cmp(board[i].end, blk.end) > 0) {
+				blk.end = board[i].end;
+			}
+
+			tcp_sack_board_del(conn, i);
+			continue;
+		}
+
+		i++;
+	}
+
+	for (i = 0; i < conn->sack_board_len; i++) {
+		if (net_tcp_seq_cmp(blk.start, board[i].start) < 0) {
+			break;
+		}
+	}
+
+	if (conn->sack_board_len == ARRAY_SIZE(conn->sack_board)) {
+		/* The lowest blocks matter most for the recovery, so forget
+		 * about the highest one.
+		 */
+		if (i == conn->sack_board_len) {
+			return;
+		}
+
+		conn->sack_board_len--;
+	}
+
+	memmove(&board[i + 1], &board[i],
+		(conn->sack_board_len - i) * sizeof(board[0]));
+	board[i] = blk;
+	conn->sack_board_len++;
+}
+
+/* Merge the SACK blocks of the received segment into the scoreboard. Only
+ * blocks covering data that has been sent but not yet acknowledged are used.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_max = conn->seq + conn->unacked_len;
+
+	if (!conn->sack_permitted) {
+		return;
+	}
+
+	for (int i = 0; i < opts->sack_count; i++) {
+		struct tcp_sack_block blk = opts->sack[i];
+
+		if (net_tcp_seq_cmp(blk.end, blk.start) <= 0 ||
+		    net_tcp_seq_cmp(blk.end, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(blk.end, snd_max) > 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(blk.start, conn->seq) < 0) {
+			blk.start = conn->seq;
+		}
+
+		tcp_sack_board_add(conn, blk);
+	}
+
+	opts->sack_count = 0;
+}
+
+/* Find the first hole at or above *pos, which is moved to its start.
+ * Holes are only looked for below the highest selectively acknowledged
+ * sequence number. Returns the length to resend, at most one MSS, or 0.
+ */
+static int tcp_sack_next_hole(struct tcp *conn, uint32_t *pos)
+{
+	for (int i = 0; i < conn->sack_board_len; i++) {
+		if (net_tcp_seq_cmp(*pos, conn->sack_board[i].start) < 0) {
+			return MIN(conn->sack_board[i].start - *pos, conn_mss(conn));
+		}
+
+		if (net_tcp_seq_cmp(*pos, conn->sack_board[i].end) < 0) {
+			*pos = conn->sack_board[i].end;
+		}
+	}
+
+	return 0;
+}
+
+/* Estimate of the data still in the network (the RFC 6675 "pipe"): the
+ * holes below the highest SACKed sequence number are considered lost, unless
+ * they have already been retransmitted during this recovery.
+ */
+static uint32_t tcp_sack_pipe(struct tcp *conn)
+{
+	uint32_t out = 0;
+	uint32_t pos = conn->seq;
+
+	for (int i = 0; i < conn->sack_board_len; i++) {
+		struct tcp_sack_block *blk = &conn->sack_board[i];
+		uint32_t hole = blk->start - pos;
+		uint32_t resent = 0;
+
+		if (net_tcp_seq_cmp(conn->sack_rexmit_next, pos) > 0) {
+			resent = MIN(conn->sack_rexmit_next - pos, hole);
+		}
+
+		out += (blk->end - blk->start) + hole - resent;
+		pos = blk->end;
+	}
+
+	return (conn->unacked_len > out) ? conn->unacked_len - out : 0;
+}
+
+/* During the recovery the data in flight is limited to the slow start
+ * threshold set when the loss was detected, as in RFC 6675. The NewReno
+ * window inflated by the duplicate ACKs would count the SACKed data twice.
+ */
+static uint32_t tcp_sack_window(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	return conn->ca.ssthresh;
+#else
+	return conn->send_win;
+#endif
+}
+
+/* Retransmit the holes from sack_rexmit_next on, as long as the data in
+ * flight stays within the window. The fast retransmit which starts the
+ * recovery sends exactly one segment, whatever the window.
+ */
+static void tcp_sack_retransmit(struct tcp *conn, bool fast_rexmit)
+{
+	uint32_t win = tcp_sack_window(conn);
+	uint32_t pipe;
+	uint32_t pos;
+	int len;
+
+	if (net_tcp_seq_cmp(conn->sack_rexmit_next, conn->seq) < 0) {
+		conn->sack_rexmit_next = conn->seq;
+	}
+
+	pos = conn->sack_rexmit_next;
+	pipe = tcp_sack_pipe(conn);
+
+	while ((len = tcp_sack_next_hole(conn, &pos)) > 0) {
+		if (!fast_rexmit && pipe + len > win) {
+			NET_DBG("conn: %p SACK retransmit limited, pipe %u win %u",
+				conn, pipe, win);
+			break;
+		}
+
+		NET_DBG("conn: %p SACK retransmit seq %u len %d",
+			conn, pos, len);
+
+		if (tcp_send_segment(conn, pos - conn->seq, len) < 0) {
+			break;
+		}
+
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+		pos += len;
+		pipe += len;
+
+		if (fast_rexmit) {
+			break;
+		}
+	}
+
+	conn->sack_rexmit_next = pos;
+}
+
+/* Start a SACK based recovery, returns false if there is nothing known
+ * about the holes so the plain fast retransmit should be used.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_permitted || conn->sack_board_len == 0) {
+		return false;
+	}
+
+	if (conn->sack_recovery) {
+		/* Duplicate ACKs after a partial ACK, keep filling the holes */
+		tcp_sack_retransmit(conn, false);
+		return true;
+	}
+
+	conn->sack_recovery = true;
+	conn->sack_recovery_point = conn->seq + conn->unacked_len;
+	conn->sack_rexmit_next = conn->seq;
+
+	tcp_sack_retransmit(conn, true);
+
+	return true;
+}
+
+/* Each further duplicate ACK means one more segment has left the network */
+static void tcp_sack_dup_ack(struct tcp *conn)
+{
+	if (conn->sack_recovery) {
+		tcp_sack_retransmit(conn, false);
+	}
+}
+
+static void tcp_sack_pkts_acked(struct tcp *conn)
+{
+	while (conn->sack_board_len > 0 &&
+	       net_tcp_seq_cmp(conn->sack_board[0].end, conn->seq) <= 0) {
+		tcp_sack_board_del(conn, 0);
+	}
+
+	if (conn->sack_board_len > 0 &&
+	    net_tcp_seq_cmp(conn->sack_board[0].start, conn->seq) < 0) {
+		conn->sack_board[0].start = conn->seq;
+	}
+
+	if (!conn->sack_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->sack_recovery_point) >= 0) {
+		conn->sack_recovery = false;
+		return;
+	}
+
+	/* Partial ACK, the next holes can be filled right away */
+	tcp_sack_retransmit(conn, false);
+}
+
+/* The peer is allowed to discard data it has selectively acknowledged, so
+ * the scoreboard cannot be trusted anymore after a retransmission timeout.
+ */
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack_board_len = 0;
+	conn->sack_recovery = false;
+}
+#else
+static inline void tcp_sack_update(struct tcp *conn) { }
+
+static inline bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	return false;
+}
+
+static inline void tcp_sack_dup_ack(struct tcp *conn) { }
+
+static inline void tcp_sack_pkts_acked(struct tcp *conn) { }
+
+static inline void tcp_sack_reset(struct tcp *conn) { }
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1891,6 +2491,7 @@ static void tcp_resend_data(struct k_work *work)
 
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	tcp_sack_reset(conn);
 
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
@@ -2146,6 +2747,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca_ops = TCP_CA_DEFAULT;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2203,34 +2805,28 @@ int net_tcp_get(struct net_context *context)
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
-{
-	union tcp_endpoint ep_tmp;
-
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
-	}
-
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
-}
-
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
-{
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
-}
-
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
+	union tcp_endpoint local;
+	union tcp_endpoint remote;
+	sys_slist_t *bucket;
 	bool found = false;
 	struct tcp *conn;
-	struct tcp *tmp;
+	size_t len;
+
+	if (tcp_endpoint_set(&local, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&remote, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	len = tcp_endpoint_len(local.sa.sa_family);
+	bucket = tcp_conn_hash_bucket(&local, &remote);
 
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, hash_next) {
+		found = !memcmp(&conn->src, &local, len) &&
+			!memcmp(&conn->dst, &remote, len);
 		if (found) {
 			break;
 		}
@@ -2427,6 +3023,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_update(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr),
@@ -2876,7 +3474,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len, (fl & SYN) != 0U)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2934,6 +3532,7 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_sack_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -2970,6 +3569,7 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_ops_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3059,6 +3659,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_sack_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3142,6 +3743,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3162,20 +3767,24 @@ next_state:
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				if (!tcp_sack_recovery_start(conn)) {
+					/* Apply a fast retransmit */
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) && (len == 0)) {
+				tcp_sack_dup_ack(conn);
 			}
 		}
 #endif
@@ -3222,6 +3831,10 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			if (conn->data_mode == TCP_DATA_MODE_SEND) {
+				tcp_sack_pkts_acked(conn);
+			}
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3912,6 +4525,10 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	if (ret == 0) {
+		tcp_conn_hash_update(conn);
+	}
+
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
@@ -4089,7 +4706,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The checksums of a GSO packet are computed per segment */
+	if (net_pkt_gso_size(pkt) == 0U &&
+	    (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4143,6 +4762,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_update(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -4468,6 +5088,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4505,6 +5128,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, implementation according to RFC 9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor beta = 0.7 and scaling constant C = 0.4,
+ * both scaled by CUBIC_SCALE.
+ */
+#define CUBIC_SCALE 10
+#define CUBIC_BETA 7
+#define CUBIC_C 4
+
+/* Additive increase of the Reno friendly estimate 3 * (1 - beta) / (1 + beta),
+ * scaled by 100.
+ */
+#define CUBIC_ALPHA_AIMD 53
+
+/* C is given in segments/s^3 while the time is kept in ms */
+#define CUBIC_MSEC3_PER_SEC3 (1000ULL * 1000ULL * 1000ULL)
+
+/* Limit the time distance to K so that the cube cannot overflow */
+#define CUBIC_MAX_DELTA_MS 30000
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.pending_fast_retransmit_bytes, conn->ca.cubic.w_max,
+		conn->ca.cubic.k);
+}
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+/* Window in bytes the cubic function gives t ms into the current epoch */
+static uint32_t tcp_cubic_window(struct tcp *conn, uint32_t t)
+{
+	int64_t delta = (int64_t)t - conn->ca.cubic.k;
+	int64_t w;
+
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+
+	w = (int64_t)conn->ca.cubic.w_max +
+		(CUBIC_C * delta * delta * delta * conn_mss(conn)) /
+		((int64_t)CUBIC_SCALE * CUBIC_MSEC3_PER_SEC3);
+
+	return CLAMP(w, 0, UINT16_MAX);
+}
+
+static void tcp_cubic_epoch_start(struct tcp *conn)
+{
+	uint32_t now = k_uptime_get_32();
+
+	/* 0 is reserved for "no epoch running" */
+	conn->ca.cubic.epoch_start = now ? now : 1;
+	conn->ca.cubic.w_est = conn->ca.cwnd;
+
+	if (conn->ca.cwnd < conn->ca.cubic.w_max) {
+		/* K = cbrt((w_max - cwnd) / C), in ms and bytes */
+		uint64_t diff = conn->ca.cubic.w_max - conn->ca.cwnd;
+
+		conn->ca.cubic.k = tcp_cubic_cbrt(diff * CUBIC_SCALE * CUBIC_MSEC3_PER_SEC3 /
+						  (CUBIC_C * conn_mss(conn)));
+	} else {
+		conn->ca.cubic.k = 0;
+		conn->ca.cubic.w_max = conn->ca.cwnd;
+	}
+}
+
+static void tcp_cubic_congestion_avoidance(struct tcp *conn, uint32_t win_inc)
+{
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	if (conn->ca.cubic.epoch_start == 0) {
+		tcp_cubic_epoch_start(conn);
+	}
+
+	target = tcp_cubic_window(conn, k_uptime_get_32() - conn->ca.cubic.epoch_start);
+
+	/* Never grow slower than Reno would */
+	conn->ca.cubic.w_est += ((CUBIC_ALPHA_AIMD * conn_mss(conn) * win_inc) / 100 +
+				 cwnd - 1) / cwnd;
+	target = MAX(target, conn->ca.cubic.w_est);
+
+	if (target > cwnd) {
+		cwnd += MAX((target - cwnd) * win_inc / cwnd, 1);
+	}
+
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+}
+
+/* Remember the window at the loss, and release bandwidth faster to new flows
+ * if the window did not reach the previous maximum (fast convergence).
+ */
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	if (conn->ca.cwnd < conn->ca.cubic.w_max) {
+		conn->ca.cubic.w_max = conn->ca.cwnd * (CUBIC_SCALE + CUBIC_BETA) /
+			(2 * CUBIC_SCALE);
+	} else {
+		conn->ca.cubic.w_max = conn->ca.cwnd;
+	}
+
+	conn->ca.cubic.epoch_start = 0;
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				conn->unacked_len * CUBIC_BETA / CUBIC_SCALE);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.cubic.epoch_start = 0;
+	conn->ca.cubic.w_max = 0;
+	conn->ca.cubic.k = 0;
+	tcp_cubic_log(conn, "init");
+}
+
+static void tcp_cubic_on_loss(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the segments that left the network */
+		conn->ca.cwnd = MIN(conn_mss(conn) * 3 + conn->ca.ssthresh, UINT16_MAX);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_on_rto(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_on_dup_ack(struct tcp *conn)
+{
+	int32_t new_win = conn->ca.cwnd;
+
+	new_win += conn_mss(conn);
+	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	tcp_cubic_log(conn, "dup_ack");
+}
+
+static void tcp_cubic_on_ack(struct tcp *conn, uint32_t acked_len)
+{
+	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= acked_len;
+		}
+	} else if (conn->ca.cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(conn->ca.cwnd + win_inc, UINT16_MAX);
+	} else {
+		tcp_cubic_congestion_avoidance(conn, win_inc);
+	}
+
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.on_ack = tcp_cubic_on_ack,
+	.on_dup_ack = tcp_cubic_on_dup_ack,
+	.on_loss = tcp_cubic_on_loss,
+	.on_rto = tcp_cubic_on_rto,
+};
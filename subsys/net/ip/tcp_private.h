@@ -227,34 +227,92 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Max number of SACK blocks that fit in the TCP option space */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_perm_found : 1;
+#endif
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+struct tcp_collision_avoidance_state {
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	struct {
+		uint32_t epoch_start; /* ms, 0 when no epoch is running */
+		uint32_t k;           /* ms until the window is back at w_max */
+		uint32_t w_max;       /* window before the last reduction */
+		uint32_t w_est;       /* Reno friendly window estimate */
+	} cubic;
+#endif
 };
 #endif
 
 struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+
+/* Congestion control algorithm. All the callbacks are called with the
+ * connection lock held.
+ */
+struct tcp_ca_ops {
+	/* Name used with the TCP_CONGESTION socket option */
+	const char *name;
+	/* Connection established, set up the initial window */
+	void (*init)(struct tcp *conn);
+	/* New data has been acknowledged */
+	void (*on_ack)(struct tcp *conn, uint32_t acked_len);
+	/* Duplicate acknowledgement received */
+	void (*on_dup_ack)(struct tcp *conn);
+	/* Loss detected from duplicate acknowledgements */
+	void (*on_loss)(struct tcp *conn);
+	/* Retransmission timer expired */
+	void (*on_rto)(struct tcp *conn);
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+extern const struct tcp_ca_ops tcp_ca_cubic;
+#endif
+#endif
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_next;
+	sys_slist_t *hash_bucket;
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -323,9 +381,17 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	const struct tcp_ca_ops *ca_ops;
+	struct tcp_collision_avoidance_state ca;
 #endif
 	uint8_t send_data_retries;
+#ifdef CONFIG_NET_TCP_SACK
+	/* Blocks selectively acknowledged by the peer, sorted by sequence */
+	struct tcp_sack_block sack_board[NET_TCP_SACK_MAX_BLOCKS];
+	uint32_t sack_recovery_point;
+	uint32_t sack_rexmit_next;
+	uint8_t sack_board_len;
+#endif
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
@@ -338,6 +404,10 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_permitted : 1;
+	bool sack_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
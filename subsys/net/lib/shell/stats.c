@@ -538,6 +538,12 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+	PR("GRO merged     %d\tflushed\t%d\n",
+	   GET_STAT(iface, gro.merged),
+	   GET_STAT(iface, gro.flushed));
+#endif
+
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
 	PR("Bytes sent     %u\n", GET_STAT(iface, bytes.sent));
 	PR("Processing err %d\n", GET_STAT(iface, processing_error));
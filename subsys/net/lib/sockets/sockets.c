@@ -65,6 +65,9 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 		retval;					     \
 	})
 
+/* Same upper bound on the batch size as Linux (UIO_MAXIOV) */
+#define MMSG_VLEN_MAX 1024
+
 const struct socket_op_vtable sock_fd_op_vtable;
 
 static inline void *get_sock_vtable(int sock,
@@ -152,6 +155,8 @@ static void zsock_flush_queue(struct net_context *ctx)
 
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+
+	zsock_epoll_notify(ctx);
 }
 
 #if defined(CONFIG_NET_NATIVE)
@@ -277,6 +282,8 @@ int zsock_close_ctx(struct net_context *ctx)
 
 	zsock_flush_queue(ctx);
 
+	zsock_epoll_forget(ctx);
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -392,6 +399,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_epoll_notify(parent);
 	}
 
 }
@@ -446,6 +455,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_epoll_notify(ctx);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -521,6 +532,7 @@ static void zsock_connected_cb(struct net_context *ctx, int status, void *user_d
 	if (status < 0) {
 		ctx->user_data = INT_TO_POINTER(-status);
 		sock_set_error(ctx);
+		zsock_epoll_notify(ctx);
 	}
 }
 
@@ -997,93 +1009,196 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 	return bytes_sent;
 }
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count = 0;
+	ssize_t bytes_sent;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	/* Send all the messages under a single lock of the socket */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	while (count < vlen) {
+		struct msghdr *msg = &msgvec[count].msg_hdr;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock, msg, flags);
+
+		bytes_sent = vtable->sendmsg(obj, msg, flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+					       bytes_sent < 0 ? -errno : bytes_sent);
+
+		sock_obj_core_update_send_stats(sock, bytes_sent);
+
+		if (bytes_sent < 0) {
+			break;
+		}
+
+		msgvec[count++].msg_len = bytes_sent;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after the first message is left for the next call to report */
+	return count > 0 ? count : -1;
+}
+
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+/* Copy a message to be sent from user memory, the copy must be released with
+ * sendmsg_user_copy_free() whatever the result.
+ */
+static int sendmsg_user_copy(struct msghdr *msg_copy, const struct msghdr *msg)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
-		goto fail;
+		return -1;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
+	/* Clear the pointers in the copy so that if the allocation in the
+	 * next loop fails, we do not try to free non allocated memory.
+	 */
+	memset(msg_copy->msg_iov, 0, msg_copy->msg_iovlen * sizeof(struct iovec));
+
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							    msg->msg_namelen);
+		if (!msg_copy->msg_name) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+		msg_copy->msg_control = k_usermode_alloc_from_copy(msg->msg_control,
+							       msg->msg_controllen);
+		if (!msg_copy->msg_control) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
+	return 0;
+}
+
+static void sendmsg_user_copy_free(struct msghdr *msg_copy)
+{
+	size_t i;
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	if (msg_copy->msg_iov) {
+		for (i = 0; i < msg_copy->msg_iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret = -1;
+
+	if (sendmsg_user_copy(&msg_copy, msg) == 0) {
+		ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+					   flags);
 	}
 
-	k_free(msg_copy.msg_iov);
+	sendmsg_user_copy_free(&msg_copy);
 
 	return ret;
+}
+#include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	unsigned int i, copied;
+	int ret = -1;
+
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	if (!msgvec_copy) {
+		errno = ENOMEM;
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	for (copied = 0; copied < vlen; copied++) {
+		if (sendmsg_user_copy(&msgvec_copy[copied].msg_hdr,
+				      &msgvec[copied].msg_hdr) < 0) {
+			copied++;
+			goto out;
 		}
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
 
-		k_free(msg_copy.msg_iov);
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
 	}
 
-	return -1;
+out:
+	for (i = 0; i < copied; i++) {
+		sendmsg_user_copy_free(&msgvec_copy[i].msg_hdr);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
@@ -1956,13 +2071,76 @@ ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 	return bytes_received;
 }
 
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count = 0;
+	ssize_t bytes_received;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	/* Drain the messages under a single lock of the socket */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	while (count < vlen) {
+		struct msghdr *msg = &msgvec[count].msg_hdr;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmsg, sock, msg, flags);
+
+		bytes_received = vtable->recvmsg(obj, msg, flags & ~ZSOCK_MSG_WAITFORONE);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmsg, sock, msg,
+					       bytes_received < 0 ? -errno : bytes_received);
+
+		sock_obj_core_update_recv_stats(sock, bytes_received);
+
+		if (bytes_received < 0) {
+			break;
+		}
+
+		msgvec[count++].msg_len = bytes_received;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after the first message is left for the next call to report */
+	return count > 0 ? count : -1;
+}
+
 #ifdef CONFIG_USERSPACE
-ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+/* Copy a receive message descriptor from user memory, the copy must be
+ * released with recvmsg_user_copy_free() whatever the result. The original
+ * iovec count is returned in iovlen as the receive may lower msg_iovlen.
+ */
+static int recvmsg_user_copy(struct msghdr *msg_copy, struct msghdr *msg,
+			     size_t *iovlen)
 {
-	struct msghdr msg_copy;
-	size_t iovlen;
 	size_t i;
-	int ret;
+
+	memset(msg_copy, 0, sizeof(*msg_copy));
+	*iovlen = 0;
 
 	if (msg == NULL) {
 		errno = EINVAL;
@@ -1974,158 +2152,395 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 		return -1;
 	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
-
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
-		goto fail;
+		return -1;
 	}
 
+	*iovlen = msg_copy->msg_iovlen;
+
 	/* Clear the pointers in the copy so that if the allocation in the
-	 * next loop fails, we do not try to free non allocated memory
-	 * in fail branch.
+	 * next loop fails, we do not try to free non allocated memory.
 	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	memset(msg_copy->msg_iov, 0, *iovlen * sizeof(struct iovec));
 
-	for (i = 0; i < iovlen; i++) {
+	for (i = 0; i < *iovlen; i++) {
 		/* TODO: In practice we do not need to copy the actual data
 		 * in msghdr when receiving data but currently there is no
 		 * ready made function to do just that (unless we want to call
 		 * relevant malloc function here ourselves). So just use
 		 * the copying variant for now.
 		 */
-		msg_copy.msg_iov[i].iov_base =
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
 		if (msg->msg_name == NULL) {
 			errno = EINVAL;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+							    msg->msg_namelen);
+		if (msg_copy->msg_name == NULL) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
 		if (msg->msg_control == NULL) {
 			errno = EINVAL;
-			goto fail;
+			return -1;
 		}
 
-		msg_copy.msg_control =
+		msg_copy->msg_control =
 			k_usermode_alloc_from_copy(msg->msg_control,
 						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
+		if (msg_copy->msg_control == NULL) {
 			errno = ENOMEM;
-			goto fail;
+			return -1;
 		}
 	}
 
-	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+	return 0;
+}
 
-	/* Do not copy anything back if there was an error or nothing was
-	 * received.
-	 */
-	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
-		}
+/* Copy the received data and message metadata back to user memory */
+static void recvmsg_user_copy_back(struct msghdr *msg, struct msghdr *msg_copy,
+				   size_t iovlen)
+{
+	size_t i;
+
+	if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_name,
+					  msg_copy->msg_name,
+					  msg_copy->msg_namelen));
+	}
+
+	if (msg->msg_controllen > 0 &&
+	    msg->msg_control != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_control,
+					  msg_copy->msg_control,
+					  msg_copy->msg_controllen));
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+		msg->msg_controllen = msg_copy->msg_controllen;
+	} else {
+		msg->msg_controllen = 0U;
+	}
+
+	k_usermode_to_copy(&msg->msg_iovlen,
+			   &msg_copy->msg_iovlen,
+			   sizeof(msg->msg_iovlen));
 
-			msg->msg_controllen = msg_copy.msg_controllen;
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(msg_copy->msg_iovlen <= iovlen);
+
+	for (i = 0; i < iovlen; i++) {
+		if (i < msg_copy->msg_iovlen) {
+			K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_len));
+			K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
+						  &msg_copy->msg_iov[i].iov_len,
+						  sizeof(msg->msg_iov[i].iov_len)));
 		} else {
-			msg->msg_controllen = 0U;
+			/* Clear out those vectors that we could not populate */
+			msg->msg_iov[i].iov_len = 0;
 		}
+	}
+
+	k_usermode_to_copy(&msg->msg_flags,
+			   &msg_copy->msg_flags,
+			   sizeof(msg->msg_flags));
+}
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
+static void recvmsg_user_copy_free(struct msghdr *msg_copy, size_t iovlen)
+{
+	size_t i;
 
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
 
+	if (msg_copy->msg_iov) {
+		/* Note that we need to free according to original iovlen */
 		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
-			}
+			k_free(msg_copy->msg_iov[i].iov_base);
 		}
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+		k_free(msg_copy->msg_iov);
 	}
+}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	struct msghdr msg_copy;
+	size_t iovlen;
+	int ret = -1;
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	if (recvmsg_user_copy(&msg_copy, msg, &iovlen) == 0) {
+		ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+		/* Do not copy anything back if there was an error or nothing
+		 * was received.
+		 */
+		if (ret > 0) {
+			recvmsg_user_copy_back(msg, &msg_copy, iovlen);
+		}
 	}
 
-	k_free(msg_copy.msg_iov);
+	recvmsg_user_copy_free(&msg_copy, iovlen);
 
 	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	unsigned int i, copied = 0;
+	size_t *iovlens;
+	int ret = -1;
+
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags);
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	iovlens = k_calloc(vlen, sizeof(*iovlens));
+	if (!msgvec_copy || !iovlens) {
+		errno = ENOMEM;
+		goto out;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	for (copied = 0; copied < vlen; copied++) {
+		if (recvmsg_user_copy(&msgvec_copy[copied].msg_hdr,
+				      &msgvec[copied].msg_hdr,
+				      &iovlens[copied]) < 0) {
+			copied++;
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		if (msgvec_copy[i].msg_len > 0) {
+			recvmsg_user_copy_back(&msgvec[i].msg_hdr,
+					       &msgvec_copy[i].msg_hdr, iovlens[i]);
 		}
 
-		k_free(msg_copy.msg_iov);
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
 	}
 
-	return -1;
+out:
+	for (i = 0; i < copied; i++) {
+		recvmsg_user_copy_free(&msgvec_copy[i].msg_hdr, iovlens[i]);
+	}
+
+	k_free(iovlens);
+	k_free(msgvec_copy);
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+/* Dequeue the next packet with data, *pkt is set to NULL on EOF */
+static int zsock_recv_zc_get_pkt(struct net_context *ctx, int flags,
+				 struct net_pkt **pkt)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	k_timepoint_t end;
+	int ret;
+
+	*pkt = NULL;
+
+	if (sock_type == SOCK_STREAM &&
+	    net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_is_error(ctx)) {
+			return -POINTER_TO_INT(ctx->user_data);
+		}
+
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		*pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (*pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				return -EAGAIN;
+			}
+
+			continue;
+		}
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(*pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+		    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+			net_socket_update_tc_rx_time(*pkt, k_cycle_get_32());
+		}
+
+		/* A stream packet may have been fully consumed by recv() */
+		if (sock_type == SOCK_STREAM && net_pkt_remaining_data(*pkt) == 0) {
+			net_pkt_unref(*pkt);
+			*pkt = NULL;
+			continue;
+		}
+
+		return 0;
+	}
+}
+
+ssize_t zsock_recv_zc(int sock, struct zsock_recv_zc_buf *zc, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	struct net_pkt *pkt;
+	ssize_t ret = -1;
+	int err;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* The buffers can only be lent by the native sockets */
+	if (vtable != &sock_fd_op_vtable ||
+	    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	     net_if_is_ip_offloaded(net_context_get_iface(ctx)))) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ~ZSOCK_MSG_DONTWAIT) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	err = zsock_recv_zc_get_pkt(ctx, flags, &pkt);
+	if (err < 0) {
+		errno = -err;
+		goto unlock;
+	}
+
+	if (pkt == NULL) {
+		/* EOF of a stream socket */
+		ret = 0;
+		goto unlock;
+	}
+
+	if (src_addr != NULL && addrlen != NULL) {
+		err = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (err < 0) {
+			net_pkt_unref(pkt);
+			errno = -err;
+			goto unlock;
+		}
+
+		*addrlen = src_addr->sa_family == AF_INET ?
+			   sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6);
+	}
+
+	/* The headers were already parsed, the data starts at the cursor.
+	 * Leave the fragments in the packet so that they are freed with it.
+	 */
+	zc->pkt = pkt;
+	zc->ctx = NULL;
+	zc->len = net_pkt_remaining_data(pkt);
+	zc->frags = pkt->cursor.buf;
+	zc->offset = zc->frags == NULL ? 0 : pkt->cursor.pos - zc->frags->data;
+
+	/* The descriptor may be closed and reused before the data is
+	 * released, keep the context for the receive window update.
+	 */
+	if (net_context_get_type(ctx) == SOCK_STREAM) {
+		net_context_ref(ctx);
+		zc->ctx = ctx;
+	}
+
+	ret = zc->len;
+
+unlock:
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(struct zsock_recv_zc_buf *zc)
+{
+	struct net_context *ctx = zc->ctx;
+
+	if (zc->pkt == NULL) {
+		return;
+	}
+
+	if (ctx != NULL) {
+		if (net_context_get_state(ctx) == NET_CONTEXT_CONNECTED) {
+			(void)net_context_update_recv_wnd(ctx, zc->len);
+		}
+
+		net_context_unref(ctx);
+	}
+
+	net_pkt_unref(zc->pkt);
+
+	zc->pkt = NULL;
+	zc->ctx = NULL;
+	zc->frags = NULL;
+	zc->len = 0;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2767,6 +3182,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -3344,6 +3773,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
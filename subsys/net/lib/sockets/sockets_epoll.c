@@ -0,0 +1,882 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Persistent interest set of file descriptors (epoll).
+ *
+ * Native sockets keep a list of the interest set entries watching them, and
+ * the socket layer pushes those entries to the ready list of their instance
+ * when data, a connection, an error or EOF is received. A wait then only
+ * checks the entries on the ready list. The readiness is still confirmed
+ * with the poll ioctls of the descriptor, so a spurious push is harmless.
+ *
+ * Other descriptors, and native sockets waited for writability (TCP send
+ * window updates are not seen by the socket layer), are "polled" entries
+ * which are checked on each wait like zsock_poll() does.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/net/socket.h>
+
+#include "sockets_internal.h"
+
+#define EPOLL_POLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT)
+
+struct epoll_instance;
+
+struct epoll_item {
+	/** Node in the ready or in the polled list of the instance */
+	sys_dnode_t node;
+	/** Node in the list of all the entries of the instance */
+	sys_snode_t ep_node;
+	/** Node in the list of the entries watching a native socket */
+	sys_snode_t ctx_node;
+	/** Instance the entry belongs to */
+	struct epoll_instance *ep;
+	/** Object of the file descriptor */
+	void *obj;
+	/** Watched native socket, NULL for other descriptors */
+	struct net_context *ctx;
+	/** Requested events and user data */
+	struct zsock_epoll_event event;
+	/** Events reported last time for an edge triggered polled entry */
+	uint32_t last_revents;
+	/** Watched file descriptor */
+	int fd;
+	/* The flags below are protected by epoll_lock */
+	/** Checked on each wait instead of being pushed to the ready list */
+	bool polled;
+	/** In the ready list */
+	bool queued;
+	/** Reported with ZSOCK_EPOLLONESHOT, waiting to be re-armed */
+	bool disarmed;
+	/** The watched socket was closed */
+	bool closed;
+};
+
+__net_socket struct epoll_instance {
+	/** Serializes the waits and the interest set changes */
+	struct k_mutex lock;
+	/** Raised when an entry is pushed to the ready list */
+	struct k_poll_signal signal;
+	/** All the entries */
+	sys_slist_t items;
+	/** Entries which may be ready */
+	sys_dlist_t ready;
+	/** Entries checked on each wait */
+	sys_dlist_t polled;
+	bool in_use;
+};
+
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+
+K_MEM_SLAB_DEFINE_STATIC(epoll_item_slab, sizeof(struct epoll_item),
+			 CONFIG_NET_SOCKETS_EPOLL_ITEMS_MAX,
+			 __alignof__(struct epoll_item));
+
+/* Protects the ready lists, the entry lists of the sockets and the flags of
+ * the entries, as these are updated from the network stack.
+ */
+static struct k_spinlock epoll_lock;
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+
+/* Must be called with epoll_lock held. Returns true if the wait of the
+ * instance needs to be woken up.
+ */
+static bool epoll_item_queue(struct epoll_item *item)
+{
+	if (item->queued || item->polled || (item->disarmed && !item->closed)) {
+		return false;
+	}
+
+	sys_dlist_append(&item->ep->ready, &item->node);
+	item->queued = true;
+
+	return true;
+}
+
+static void epoll_wake(uint32_t instances)
+{
+	while (instances != 0U) {
+		int idx = find_lsb_set(instances) - 1;
+
+		(void)k_poll_signal_raise(&epoll_instances[idx].signal, 0);
+		instances &= instances - 1U;
+	}
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	uint32_t wake = 0U;
+
+	/* An entry added meanwhile is checked by the next wait anyway */
+	if (sys_slist_is_empty(&ctx->epoll_items)) {
+		return;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (epoll_item_queue(item)) {
+			wake |= BIT(ARRAY_INDEX(epoll_instances, item->ep));
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	/* Raising the signal may reschedule, so not under the spinlock */
+	epoll_wake(wake);
+}
+
+void zsock_epoll_forget(struct net_context *ctx)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	uint32_t wake = 0U;
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_slist_get(&ctx->epoll_items)) != NULL) {
+		item = CONTAINER_OF(node, struct epoll_item, ctx_node);
+
+		/* The next wait or change of the instance drops the entry, it
+		 * cannot be done here as the instance is not locked.
+		 */
+		item->ctx = NULL;
+		item->closed = true;
+
+		if (epoll_item_queue(item)) {
+			wake |= BIT(ARRAY_INDEX(epoll_instances, item->ep));
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	epoll_wake(wake);
+}
+
+/* Must be called with the instance locked */
+static void epoll_item_free(struct epoll_item *item)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->ctx != NULL) {
+		(void)sys_slist_find_and_remove(&item->ctx->epoll_items,
+						&item->ctx_node);
+	}
+
+	if (item->queued || item->polled) {
+		sys_dlist_remove(&item->node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	(void)sys_slist_find_and_remove(&item->ep->items, &item->ep_node);
+
+	k_mem_slab_free(&epoll_item_slab, item);
+}
+
+/* Get the current events of the watched descriptor with the poll ioctls */
+static int epoll_item_check(struct epoll_item *item, uint32_t *revents)
+{
+	struct zsock_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->event.events & EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event poll_events[2];
+	struct k_poll_event *pev = poll_events;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	*revents = 0U;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL || obj != item->obj) {
+		/* The descriptor was closed */
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+				      &pfd, &pev, poll_events + ARRAY_SIZE(poll_events));
+	if (ret == 0 || ret == -EALREADY) {
+		if (pev != poll_events) {
+			(void)k_poll(poll_events, pev - poll_events, K_NO_WAIT);
+		}
+
+		pev = poll_events;
+		ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE,
+					      &pfd, &pev);
+	}
+
+	k_mutex_unlock(lock);
+
+	if (ret == -EAGAIN) {
+		/* Not ready yet, e.g. TLS handshake in progress */
+		return 0;
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	*revents = (uint16_t)pfd.revents;
+
+	return 0;
+}
+
+/* Fill in the returned event if the entry has something to report */
+static bool epoll_item_report(struct epoll_item *item, uint32_t revents,
+			      struct zsock_epoll_event *event)
+{
+	k_spinlock_key_t key;
+
+	if (item->polled && (item->event.events & ZSOCK_EPOLLET)) {
+		/* Without pushes the edges are the changes of the events */
+		uint32_t new_revents = revents & ~item->last_revents;
+
+		item->last_revents = revents;
+
+		if (new_revents == 0U) {
+			return false;
+		}
+	}
+
+	if (revents == 0U) {
+		return false;
+	}
+
+	event->events = revents;
+	event->data = item->event.data;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->event.events & ZSOCK_EPOLLONESHOT) {
+		item->disarmed = true;
+	} else if (!(item->event.events & ZSOCK_EPOLLET)) {
+		/* Level triggered, stays ready until it is checked otherwise */
+		(void)epoll_item_queue(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return true;
+}
+
+/* Must be called with the instance locked */
+static int epoll_collect(struct epoll_instance *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_item *item, *next;
+	k_spinlock_key_t key;
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+	uint32_t revents;
+	bool closed = false;
+	int count = 0;
+	int ret;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->polled, item, next, node) {
+		if (count == maxevents) {
+			break;
+		}
+
+		if (item->disarmed) {
+			continue;
+		}
+
+		ret = epoll_item_check(item, &revents);
+		if (ret == -EBADF) {
+			epoll_item_free(item);
+			continue;
+		} else if (ret < 0) {
+			/* Keep watching the descriptor, but report the error */
+			NET_DBG("fd %d poll failed (%d)", item->fd, ret);
+			revents = ZSOCK_EPOLLERR;
+		}
+
+		if (epoll_item_report(item, revents, &events[count])) {
+			count++;
+		}
+	}
+
+	/* Take the current ready list, the level triggered entries which are
+	 * still ready are queued back to it while going through it.
+	 */
+	sys_dlist_init(&pending);
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_dlist_get(&ep->ready)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	while (count < maxevents) {
+		key = k_spin_lock(&epoll_lock);
+
+		node = sys_dlist_get(&pending);
+		if (node != NULL) {
+			item = CONTAINER_OF(node, struct epoll_item, node);
+			item->queued = false;
+			closed = item->closed;
+		}
+
+		k_spin_unlock(&epoll_lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		if (closed) {
+			epoll_item_free(item);
+			continue;
+		}
+
+		ret = epoll_item_check(item, &revents);
+		if (ret == -EBADF) {
+			epoll_item_free(item);
+			continue;
+		} else if (ret < 0) {
+			/* Keep watching the descriptor, but report the error */
+			NET_DBG("fd %d poll failed (%d)", item->fd, ret);
+			revents = ZSOCK_EPOLLERR;
+		}
+
+		if (epoll_item_report(item, revents, &events[count])) {
+			count++;
+		}
+	}
+
+	/* Entries not looked at are still ready */
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_dlist_peek_tail(&pending)) != NULL) {
+		sys_dlist_remove(node);
+		sys_dlist_prepend(&ep->ready, node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+/* Must be called with the instance locked. Returns the number of poll events
+ * to wait for, or -EALREADY if there is no need to wait.
+ */
+static int epoll_prepare_wait(struct epoll_instance *ep,
+			      struct k_poll_event *poll_events, int max_events)
+{
+	struct k_poll_event *pev = poll_events;
+	struct k_poll_event *pev_end = poll_events + max_events;
+	const struct fd_op_vtable *vtable;
+	struct epoll_item *item;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	k_poll_event_init(pev++, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &ep->signal);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->polled, item, node) {
+		struct zsock_pollfd pfd = {
+			.fd = item->fd,
+			.events = item->event.events & EPOLL_POLL_EVENTS,
+		};
+		struct k_poll_event *pev_start = pev;
+
+		if (item->disarmed) {
+			continue;
+		}
+
+		obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+		if (obj == NULL || obj != item->obj) {
+			/* Let the next check drop the entry */
+			return -EALREADY;
+		}
+
+		(void)k_mutex_lock(lock, K_FOREVER);
+
+		ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+					      &pfd, &pev, pev_end);
+
+		k_mutex_unlock(lock);
+
+		if (ret == -EALREADY) {
+			/* An edge triggered entry already reported these events,
+			 * otherwise the entry became ready after it was checked.
+			 */
+			if (item->event.events & ZSOCK_EPOLLET) {
+				pev = pev_start;
+				continue;
+			}
+
+			return -EALREADY;
+		} else if (ret < 0) {
+			/* The checks report the error, only once for an edge
+			 * triggered entry.
+			 */
+			if (item->event.events & ZSOCK_EPOLLET) {
+				pev = pev_start;
+				continue;
+			}
+
+			return -EALREADY;
+		}
+	}
+
+	return pev - poll_events;
+}
+
+static int epoll_wait_internal(struct epoll_instance *ep,
+			       struct zsock_epoll_event *events, int maxevents,
+			       k_timeout_t timeout)
+{
+	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX + 1];
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int count;
+	int ret;
+
+	while (true) {
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		/* Entries pushed from now on wake up the wait below */
+		k_poll_signal_reset(&ep->signal);
+
+		count = epoll_collect(ep, events, maxevents);
+		if (count != 0) {
+			k_mutex_unlock(&ep->lock);
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_mutex_unlock(&ep->lock);
+			break;
+		}
+
+		ret = epoll_prepare_wait(ep, poll_events, ARRAY_SIZE(poll_events));
+
+		k_mutex_unlock(&ep->lock);
+
+		if (ret == -EALREADY) {
+			continue;
+		} else if (ret < 0) {
+			count = ret;
+			break;
+		}
+
+		ret = k_poll(poll_events, ret, timeout);
+		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
+		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
+			count = ret;
+			break;
+		}
+	}
+
+	if (count < 0) {
+		errno = -count;
+		return -1;
+	}
+
+	return count;
+}
+
+/* Must be called with the instance locked */
+static void epoll_item_set(struct epoll_item *item,
+			   const struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->queued || item->polled) {
+		sys_dlist_remove(&item->node);
+		item->queued = false;
+	}
+
+	item->event = *event;
+	item->last_revents = 0U;
+	item->disarmed = false;
+	item->polled = item->ctx == NULL || (event->events & ZSOCK_EPOLLOUT);
+
+	if (item->polled) {
+		sys_dlist_append(&ep->polled, &item->node);
+	} else {
+		/* Let the next wait check the current state */
+		(void)epoll_item_queue(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	/* A wait in progress needs to take the change into account */
+	(void)k_poll_signal_raise(&ep->signal, 0);
+}
+
+/* Must be called with the instance locked */
+static int epoll_item_add(struct epoll_instance *ep, int fd, void *obj,
+			  const struct fd_op_vtable *vtable,
+			  const struct zsock_epoll_event *event)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	uint32_t revents;
+	int ret;
+
+	if (k_mem_slab_alloc(&epoll_item_slab, (void **)&item, K_NO_WAIT) != 0) {
+		return -ENOMEM;
+	}
+
+	memset(item, 0, sizeof(*item));
+
+	item->ep = ep;
+	item->fd = fd;
+	item->obj = obj;
+	item->event = *event;
+
+	/* Descriptors without the poll ioctls, like offloaded sockets, cannot
+	 * be watched.
+	 */
+	ret = epoll_item_check(item, &revents);
+	if (ret < 0) {
+		k_mem_slab_free(&epoll_item_slab, item);
+		return ret == -EBADF ? ret : -EPERM;
+	}
+
+	if (vtable == &sock_fd_op_vtable.fd_vtable) {
+		item->ctx = obj;
+
+		key = k_spin_lock(&epoll_lock);
+		sys_slist_append(&item->ctx->epoll_items, &item->ctx_node);
+		k_spin_unlock(&epoll_lock, key);
+	}
+
+	sys_slist_append(&ep->items, &item->ep_node);
+
+	epoll_item_set(item, event);
+
+	return 0;
+}
+
+/* Must be called with the instance locked */
+static struct epoll_item *epoll_item_find(struct epoll_instance *ep, int fd,
+					  void *obj)
+{
+	struct epoll_item *item, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, ep_node) {
+		if (item->closed) {
+			epoll_item_free(item);
+			continue;
+		}
+
+		if (item->fd == fd && item->obj == obj) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+static int epoll_ctl_internal(struct epoll_instance *ep, int op, int fd,
+			      const struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct epoll_item *item;
+	struct k_mutex *lock;
+	void *obj;
+	int ret = 0;
+
+	obj = zvfs_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	if (obj == ep) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_USERSPACE
+	if (k_is_in_user_syscall() && !k_object_is_valid(obj, K_OBJ_NET_SOCKET)) {
+		return -EBADF;
+	}
+#endif /* CONFIG_USERSPACE */
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	item = epoll_item_find(ep, fd, obj);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		ret = epoll_item_add(ep, fd, obj, vtable, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_set(item, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	return ret;
+}
+
+static struct epoll_instance *get_epoll_instance(int epfd)
+{
+	struct epoll_instance *ep;
+
+	ep = zvfs_get_fd_obj(epfd, &epoll_fd_op_vtable, EBADF);
+
+#ifdef CONFIG_USERSPACE
+	if (ep != NULL && k_is_in_user_syscall() &&
+	    !k_object_is_valid(ep, K_OBJ_NET_SOCKET)) {
+		errno = EBADF;
+		ep = NULL;
+	}
+#endif /* CONFIG_USERSPACE */
+
+	return ep;
+}
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct epoll_instance *ep = NULL;
+	k_spinlock_key_t key;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	ARRAY_FOR_EACH_PTR(epoll_instances, instance) {
+		if (!instance->in_use) {
+			instance->in_use = true;
+			ep = instance;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ep == NULL) {
+		zvfs_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_mutex_init(&ep->lock);
+	k_poll_signal_init(&ep->signal);
+	sys_slist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	sys_dlist_init(&ep->polled);
+
+#ifdef CONFIG_USERSPACE
+	/* Only the creating thread has access to the instance */
+	k_object_recycle(ep);
+#endif /* CONFIG_USERSPACE */
+
+	zvfs_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <zephyr/syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	int ret;
+
+	ep = get_epoll_instance(epfd);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (event == NULL && op != ZSOCK_EPOLL_CTL_DEL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	ret = epoll_ctl_internal(ep, op, fd, event);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event == NULL || op == ZSOCK_EPOLL_CTL_DEL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+	}
+
+	K_OOPS(k_usermode_from_copy(&event_copy, event, sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <zephyr/syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct epoll_instance *ep;
+
+	ep = get_epoll_instance(epfd);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return epoll_wait_internal(ep, events, maxevents,
+				   timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	size_t events_size;
+
+	if (maxevents <= 0 ||
+	    size_mul_overflow(maxevents, sizeof(*events), &events_size)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(events, events_size));
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <zephyr/syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_instance *ep = obj;
+	struct epoll_item *item, *next;
+	k_spinlock_key_t key;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, ep_node) {
+		epoll_item_free(item);
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	key = k_spin_lock(&epoll_lock);
+	ep->in_use = false;
+	k_spin_unlock(&epoll_lock, key);
+
+	return 0;
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
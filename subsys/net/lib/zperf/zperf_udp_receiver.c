@@ -35,6 +35,7 @@ static struct sockaddr_in *in4_addr_my;
 #define SOCK_ID_MAX 2
 
 #define UDP_RECEIVER_BUF_SIZE 1500
+#define UDP_RECEIVER_BATCH_SIZE CONFIG_NET_ZPERF_UDP_BATCH_SIZE
 #define POLL_TIMEOUT_MS 100
 
 static zperf_callback udp_session_cb;
@@ -311,14 +312,51 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
+#if UDP_RECEIVER_BATCH_SIZE > 1
+/* Drain up to a batch of datagrams with a single recvmmsg() call */
+static int udp_recv_batch(int sock)
+{
+	static uint8_t bufs[UDP_RECEIVER_BATCH_SIZE][UDP_RECEIVER_BUF_SIZE];
+	static struct sockaddr addrs[UDP_RECEIVER_BATCH_SIZE];
+	static struct iovec iovs[UDP_RECEIVER_BATCH_SIZE];
+	static struct mmsghdr msgs[UDP_RECEIVER_BATCH_SIZE];
+	int ret;
+
+	for (int i = 0; i < UDP_RECEIVER_BATCH_SIZE; i++) {
+		iovs[i].iov_base = bufs[i];
+		iovs[i].iov_len = sizeof(bufs[i]);
+
+		memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	ret = zsock_recvmmsg(sock, msgs, ARRAY_SIZE(msgs),
+			     ZSOCK_MSG_WAITFORONE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sock, &addrs[i], bufs[i], msgs[i].msg_len);
+	}
+
+	return ret;
+}
+#endif /* UDP_RECEIVER_BATCH_SIZE > 1 */
+
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
+#if UDP_RECEIVER_BATCH_SIZE == 1
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+#endif
 	int ret = 0;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -340,8 +378,12 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		return 0;
 	}
 
+#if UDP_RECEIVER_BATCH_SIZE > 1
+	ret = udp_recv_batch(pev->event.fd);
+#else
 	ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), 0,
 			     &addr, &addrlen);
+#endif
 	if (ret < 0) {
 		ret = -errno;
 		(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
@@ -351,7 +393,9 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		goto error;
 	}
 
+#if UDP_RECEIVER_BATCH_SIZE == 1
 	udp_received(pev->event.fd, &addr, buf, ret);
+#endif
 
 	return ret;
 
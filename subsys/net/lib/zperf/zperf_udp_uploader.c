@@ -20,6 +20,64 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
+#define UDP_UPLOAD_BATCH_SIZE CONFIG_NET_ZPERF_UDP_BATCH_SIZE
+#define UDP_UPLOAD_HDR_SIZE (sizeof(struct zperf_udp_datagram) + \
+			     sizeof(struct zperf_client_hdr_v1))
+
+static void udp_upload_fill_hdr(uint8_t *buf, uint32_t id, uint32_t secs,
+				uint32_t usecs, int port, uint32_t rate_in_kbps,
+				uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+#if UDP_UPLOAD_BATCH_SIZE > 1
+/* Send a batch of datagrams with a single sendmmsg() call. Only the headers
+ * differ between the datagrams, the payload is shared from sample_packet.
+ */
+static int udp_upload_send_batch(int sock, uint32_t first_id, uint32_t secs,
+				 uint32_t usecs, int port, uint32_t rate_in_kbps,
+				 uint32_t packet_size)
+{
+	static uint8_t hdrs[UDP_UPLOAD_BATCH_SIZE][UDP_UPLOAD_HDR_SIZE];
+	static struct iovec iovs[UDP_UPLOAD_BATCH_SIZE][2];
+	static struct mmsghdr msgs[UDP_UPLOAD_BATCH_SIZE];
+	size_t hdr_len = MIN(packet_size, UDP_UPLOAD_HDR_SIZE);
+
+	for (int i = 0; i < UDP_UPLOAD_BATCH_SIZE; i++) {
+		udp_upload_fill_hdr(hdrs[i], first_id + i, secs, usecs, port,
+				    rate_in_kbps, packet_size);
+
+		iovs[i][0].iov_base = hdrs[i];
+		iovs[i][0].iov_len = hdr_len;
+		iovs[i][1].iov_base = sample_packet + hdr_len;
+		iovs[i][1].iov_len = packet_size - hdr_len;
+
+		memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+		msgs[i].msg_hdr.msg_iov = iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = ARRAY_SIZE(iovs[i]);
+	}
+
+	return zsock_sendmmsg(sock, msgs, ARRAY_SIZE(msgs), 0);
+}
+#endif /* UDP_UPLOAD_BATCH_SIZE > 1 */
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -146,7 +204,9 @@ static int udp_upload(int sock, int port,
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
+	/* The pacing below is done per batch of datagrams */
+	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us *
+							UDP_UPLOAD_BATCH_SIZE);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
 	int64_t start_time, end_time;
@@ -177,8 +237,6 @@ static int udp_upload(int sock, int port,
 	(void)memset(sample_packet, 'z', sizeof(sample_packet));
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint64_t usecs64;
 		uint32_t secs, usecs;
 		int64_t loop_time;
@@ -209,22 +267,20 @@ static int udp_upload(int sock, int port,
 		secs = usecs64 / USEC_PER_SEC;
 		usecs = usecs64 - (uint64_t)secs * USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
+#if UDP_UPLOAD_BATCH_SIZE > 1
+		/* Send the packets */
+		ret = udp_upload_send_batch(sock, nb_packets, secs, usecs, port,
+					    rate_in_kbps, packet_size);
+		if (ret < 0) {
+			NET_ERR("Failed to send the packets (%d)", errno);
+			return -errno;
+		}
 
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
+		nb_packets += ret;
+#else
+		/* Fill the packet header */
+		udp_upload_fill_hdr(sample_packet, nb_packets, secs, usecs, port,
+				    rate_in_kbps, packet_size);
 
 		/* Send the packet */
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
@@ -234,6 +290,7 @@ static int udp_upload(int sock, int port,
 		} else {
 			nb_packets++;
 		}
+#endif
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
 			if (print_time >= loop_time) {
@@ -48,6 +48,16 @@ struct settings_nvs {
 	uint16_t cache_total;
 	bool loaded;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* Open addressing hash table, unused entries have a name_id of 0 */
+	struct {
+		uint16_t name_hash;
+		uint16_t name_id;
+	} index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+
+	uint16_t index_count;
+	bool index_full;
+#endif
 };
 
 /* register nvs to be a source of settings */
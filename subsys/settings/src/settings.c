@@ -24,6 +24,201 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+/* Index of the static handlers by name segments: the children of a node are
+ * the segments which follow it in handler names, and the handler of a node
+ * is the one whose name ends with it, if any. The children are linked while
+ * the index is built, then sorted by segment so that a lookup does a binary
+ * search at each level.
+ */
+struct settings_trie_node {
+	const char *seg;
+	size_t seg_len;
+	struct settings_handler_static *handler;
+	struct settings_trie_node **children;
+	size_t child_cnt;
+	struct settings_trie_node *child;
+	struct settings_trie_node *sibling;
+};
+
+static struct settings_trie_node settings_trie_root;
+static struct settings_trie_node settings_trie[CONFIG_SETTINGS_HANDLER_TRIE_NODES];
+/* Every node but the root is the child of one node */
+static struct settings_trie_node *settings_trie_children[CONFIG_SETTINGS_HANDLER_TRIE_NODES];
+static size_t settings_trie_used;
+static bool settings_trie_ready;
+
+static int settings_trie_seg_cmp(const char *seg1, size_t len1, const char *seg2, size_t len2)
+{
+	int rc = memcmp(seg1, seg2, MIN(len1, len2));
+
+	if (rc == 0) {
+		rc = (len1 > len2) - (len1 < len2);
+	}
+
+	return rc;
+}
+
+static int settings_trie_node_cmp(const void *a, const void *b)
+{
+	const struct settings_trie_node *n1 = *(const struct settings_trie_node *const *)a;
+	const struct settings_trie_node *n2 = *(const struct settings_trie_node *const *)b;
+
+	return settings_trie_seg_cmp(n1->seg, n1->seg_len, n2->seg, n2->seg_len);
+}
+
+/* Used while the index is built */
+static struct settings_trie_node *settings_trie_child_find(struct settings_trie_node *node,
+							     const char *seg, size_t len)
+{
+	for (node = node->child; node; node = node->sibling) {
+		if ((node->seg_len == len) && (memcmp(node->seg, seg, len) == 0)) {
+			return node;
+		}
+	}
+
+	return NULL;
+}
+
+static struct settings_trie_node *settings_trie_child(struct settings_trie_node *node,
+							const char *seg, size_t len)
+{
+	size_t lo = 0;
+	size_t hi = node->child_cnt;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		struct settings_trie_node *child = node->children[mid];
+		int rc = settings_trie_seg_cmp(seg, len, child->seg, child->seg_len);
+
+		if (rc == 0) {
+			return child;
+		} else if (rc < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+static void settings_trie_sort(struct settings_trie_node *node, size_t *sorted)
+{
+	struct settings_trie_node *child;
+
+	node->children = &settings_trie_children[*sorted];
+	node->child_cnt = 0;
+	for (child = node->child; child; child = child->sibling) {
+		node->children[node->child_cnt++] = child;
+	}
+	*sorted += node->child_cnt;
+
+	qsort(node->children, node->child_cnt, sizeof(node->children[0]),
+	      settings_trie_node_cmp);
+}
+
+static int settings_trie_insert(struct settings_handler_static *ch)
+{
+	struct settings_trie_node *node = &settings_trie_root;
+	struct settings_trie_node *child;
+	const char *seg = ch->name;
+	size_t len;
+
+	while (true) {
+		len = 0;
+		while ((seg[len] != '\0') && (seg[len] != SETTINGS_NAME_SEPARATOR)) {
+			len++;
+		}
+
+		child = settings_trie_child_find(node, seg, len);
+		if (!child) {
+			if (settings_trie_used == ARRAY_SIZE(settings_trie)) {
+				return -ENOMEM;
+			}
+
+			child = &settings_trie[settings_trie_used++];
+			child->seg = seg;
+			child->seg_len = len;
+			child->sibling = node->child;
+			node->child = child;
+		}
+
+		node = child;
+		if (seg[len] == '\0') {
+			break;
+		}
+		seg += len + 1;
+	}
+
+	/* As with the linear search, the last of handlers with the same name
+	 * wins.
+	 */
+	node->handler = ch;
+
+	return 0;
+}
+
+/* Static handlers never change, the index is built once */
+static void settings_trie_build(void)
+{
+	size_t sorted = 0;
+
+	if (settings_trie_ready) {
+		return;
+	}
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		if (!ch->name) {
+			continue;
+		}
+
+		if (settings_trie_insert(ch)) {
+			LOG_WRN("Static handlers not indexed, increase "
+				"CONFIG_SETTINGS_HANDLER_TRIE_NODES");
+			return;
+		}
+	}
+
+	settings_trie_sort(&settings_trie_root, &sorted);
+	for (size_t i = 0; i < settings_trie_used; i++) {
+		settings_trie_sort(&settings_trie[i], &sorted);
+	}
+
+	settings_trie_ready = true;
+}
+
+/* Deepest handler on the path of the name segments, which is the handler with
+ * the longest name matching the name with settings_name_steq().
+ */
+static struct settings_handler_static *settings_trie_lookup(const char *name,
+							     const char **next)
+{
+	struct settings_trie_node *node = &settings_trie_root;
+	struct settings_handler_static *bestmatch = NULL;
+	const char *seg = name;
+	const char *seg_next;
+	size_t len;
+
+	while (seg) {
+		len = settings_name_next(seg, &seg_next);
+		node = settings_trie_child(node, seg, len);
+		if (!node) {
+			break;
+		}
+
+		if (node->handler) {
+			bestmatch = node->handler;
+			if (next) {
+				*next = seg_next;
+			}
+		}
+		seg = seg_next;
+	}
+
+	return bestmatch;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
 
 void settings_store_init(void);
 
@@ -32,6 +227,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+	settings_trie_build();
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
 	settings_store_init();
 }
 
@@ -134,16 +332,19 @@ int settings_name_next(const char *name, const char **next)
 	return rc;
 }
 
-struct settings_handler_static *settings_parse_and_lookup(const char *name,
-							const char **next)
+static struct settings_handler_static *settings_static_lookup(const char *name,
+							     const char **next)
 {
 	struct settings_handler_static *bestmatch;
 	const char *tmpnext;
 
-	bestmatch = NULL;
-	if (next) {
-		*next = NULL;
+#if defined(CONFIG_SETTINGS_HANDLER_TRIE)
+	if (settings_trie_ready) {
+		return settings_trie_lookup(name, next);
 	}
+#endif /* CONFIG_SETTINGS_HANDLER_TRIE */
+
+	bestmatch = NULL;
 
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
@@ -164,8 +365,23 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		}
 	}
 
+	return bestmatch;
+}
+
+struct settings_handler_static *settings_parse_and_lookup(const char *name,
+							const char **next)
+{
+	struct settings_handler_static *bestmatch;
+
+	if (next) {
+		*next = NULL;
+	}
+
+	bestmatch = settings_static_lookup(name, next);
+
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	struct settings_handler *ch;
+	const char *tmpnext;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
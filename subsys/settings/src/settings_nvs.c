@@ -120,6 +120,121 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE),
+	     "CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE must be a power of two");
+
+#define SETTINGS_NVS_INDEX_MASK (CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE - 1)
+#define SETTINGS_NVS_INDEX_MAX (CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE * 3 / 4)
+
+static uint16_t settings_nvs_name_hash(const char *name)
+{
+	return crc16_ccitt(0xffff, name, strlen(name));
+}
+
+static void settings_nvs_index_add(struct settings_nvs *cf, uint16_t name_hash,
+				   uint16_t name_id)
+{
+	uint16_t i = name_hash & SETTINGS_NVS_INDEX_MASK;
+
+	if (cf->index_count == SETTINGS_NVS_INDEX_MAX) {
+		cf->index_full = true;
+		return;
+	}
+
+	while (cf->index[i].name_id != 0) {
+		i = (i + 1) & SETTINGS_NVS_INDEX_MASK;
+	}
+
+	cf->index[i].name_hash = name_hash;
+	cf->index[i].name_id = name_id;
+	cf->index_count++;
+}
+
+static void settings_nvs_index_remove(struct settings_nvs *cf, uint16_t name_hash,
+				      uint16_t name_id)
+{
+	uint16_t i = name_hash & SETTINGS_NVS_INDEX_MASK;
+	uint16_t j, home;
+
+	while (cf->index[i].name_id != name_id) {
+		if (cf->index[i].name_id == 0) {
+			return;
+		}
+		i = (i + 1) & SETTINGS_NVS_INDEX_MASK;
+	}
+
+	/* Move back the following entries which can no longer be reached
+	 * from their home slot, up to the next unused entry.
+	 */
+	j = i;
+	while (1) {
+		j = (j + 1) & SETTINGS_NVS_INDEX_MASK;
+		if (cf->index[j].name_id == 0) {
+			break;
+		}
+
+		home = cf->index[j].name_hash & SETTINGS_NVS_INDEX_MASK;
+		if (((j - home) & SETTINGS_NVS_INDEX_MASK) >=
+		    ((j - i) & SETTINGS_NVS_INDEX_MASK)) {
+			cf->index[i] = cf->index[j];
+			i = j;
+		}
+	}
+
+	cf->index[i].name_id = 0;
+	cf->index_count--;
+}
+
+static uint16_t settings_nvs_index_match(struct settings_nvs *cf, const char *name,
+					 uint16_t name_hash, char *rdname, size_t len)
+{
+	uint16_t i = name_hash & SETTINGS_NVS_INDEX_MASK;
+	int rc;
+
+	for (; cf->index[i].name_id != 0; i = (i + 1) & SETTINGS_NVS_INDEX_MASK) {
+		if (cf->index[i].name_hash != name_hash) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, cf->index[i].name_id, rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname)) {
+			continue;
+		}
+
+		return cf->index[i].name_id;
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+static void settings_nvs_index_build(struct settings_nvs *cf)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	ssize_t rc;
+
+	memset(cf->index, 0, sizeof(cf->index));
+	cf->index_count = 0;
+	cf->index_full = false;
+
+	for (uint16_t name_id = cf->last_name_id; name_id > NVS_NAMECNT_ID; name_id--) {
+		rc = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		if (rc <= 0) {
+			continue;
+		}
+
+		name[rc] = '\0';
+		settings_nvs_index_add(cf, settings_nvs_name_hash(name), name_id);
+	}
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -182,6 +297,14 @@ static int settings_nvs_load(struct settings_store *cs,
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			if (rc1 > 0) {
+				name[rc1] = '\0';
+				settings_nvs_index_remove(cf, settings_nvs_name_hash(name),
+							  name_id);
+			}
+#endif
+
 			if (name_id == cf->last_name_id) {
 				cf->last_name_id--;
 				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -240,10 +363,33 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	uint16_t name_hash = settings_nvs_name_hash(name);
+
+	name_id = settings_nvs_index_match(cf, name, name_hash, rdname, sizeof(rdname));
+	if (name_id != NVS_NAMECNT_ID) {
+		write_name_id = name_id;
+		write_name = false;
+		goto found;
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* A name missing from an index which is not full is not stored. The
+	 * records are still scanned for a free ID when all IDs after the
+	 * largest one in use are taken.
+	 */
+	if (!cf->index_full &&
+	    (write_name_id != NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET)) {
+		name_id = NVS_NAMECNT_ID;
+		goto found;
+	}
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	/* We can skip reading NVS if we know that the cache wasn't overflowed. */
 	if (cf->loaded && !SETTINGS_NVS_CACHE_OVFL(cf)) {
@@ -297,6 +443,10 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_remove(cf, name_hash, name_id);
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -351,6 +501,12 @@ found:
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (write_name) {
+		settings_nvs_index_add(cf, name_hash, write_name_id);
+	}
+#endif
+
 	return 0;
 }
 
@@ -378,6 +534,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	settings_nvs_index_build(cf);
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
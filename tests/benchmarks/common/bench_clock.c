@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+#include "bench_clock.h"
+
+#if defined(CONFIG_ARCH_POSIX)
+/* Implemented in bench_clock_bottom.c, on the host side */
+extern uint64_t bench_clock_host_ns(void);
+
+static uint64_t start_ns;
+
+void bench_clock_init(void)
+{
+	start_ns = bench_clock_host_ns();
+}
+
+uint64_t bench_clock_ns(void)
+{
+	return bench_clock_host_ns() - start_ns;
+}
+#else
+static timing_t start;
+
+void bench_clock_init(void)
+{
+	timing_init();
+	timing_start();
+	start = timing_counter_get();
+}
+
+uint64_t bench_clock_ns(void)
+{
+	timing_t now = timing_counter_get();
+
+	return timing_cycles_to_ns(timing_cycles_get(&start, &now));
+}
+#endif /* CONFIG_ARCH_POSIX */
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BENCHMARKS_COMMON_BENCH_CLOCK_H_
+#define ZEPHYR_TESTS_BENCHMARKS_COMMON_BENCH_CLOCK_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Start the benchmark clock.
+ *
+ * Must be called once before bench_clock_ns().
+ */
+void bench_clock_init(void);
+
+/**
+ * @brief Get the current benchmark time.
+ *
+ * On the POSIX architecture this is the host monotonic clock, elsewhere
+ * it is derived from the timing functions.
+ *
+ * @return Nanoseconds since bench_clock_init() was called.
+ */
+uint64_t bench_clock_ns(void);
+
+#endif /* ZEPHYR_TESTS_BENCHMARKS_COMMON_BENCH_CLOCK_H_ */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend_fs.h>
+#include <zephyr/stats/stats.h>
+
+/* Measure the cost of logging to a file on littlefs, on the flash
+ * simulator which takes time to program and erase the flash.  A number of
+ * messages are logged, pacing the producer so that none is dropped, and
+ * the number of bytes of logs written per second and the number of flash
+ * operations are reported.
+ */
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define N_MSGS 300
+#define MAX_PENDING 16
+#define MAX_PATH_LEN 64
+
+#define LOG_PREFIX CONFIG_LOG_BACKEND_FS_FILE_PREFIX
+
+struct flash_stat {
+	const char *name;
+	uint32_t *value;
+};
+
+static struct flash_stat flash_stats[] = {
+	{ "bytes_written" },
+	{ "flash_write_calls" },
+	{ "flash_erase_calls" },
+};
+
+static int flash_stat_find(struct stats_hdr *hdr, void *arg,
+			   const char *name, uint16_t off)
+{
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < ARRAY_SIZE(flash_stats); i++) {
+		if (strcmp(name, flash_stats[i].name) == 0) {
+			flash_stats[i].value = (uint32_t *)((uint8_t *)hdr + off);
+		}
+	}
+
+	return 0;
+}
+
+/* Remove the log files when delete is true, returns the sum of their sizes */
+static size_t log_files(bool delete)
+{
+	char fname[MAX_PATH_LEN];
+	struct fs_dirent ent;
+	struct fs_dir_t dir;
+	size_t total = 0;
+
+	fs_dir_t_init(&dir);
+
+	if (fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR) != 0) {
+		return 0;
+	}
+
+	while ((fs_readdir(&dir, &ent) == 0) && (ent.name[0] != 0)) {
+		if ((ent.type != FS_DIR_ENTRY_FILE) ||
+		    (strncmp(ent.name, LOG_PREFIX, strlen(LOG_PREFIX)) != 0)) {
+			continue;
+		}
+
+		total += ent.size;
+
+		if (delete) {
+			snprintf(fname, sizeof(fname), "%s/%s",
+				 CONFIG_LOG_BACKEND_FS_DIR, ent.name);
+			(void)fs_unlink(fname);
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+	return total;
+}
+
+int main(void)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	uint32_t start[ARRAY_SIZE(flash_stats)];
+	int64_t start_ms, elapsed_ms;
+	size_t bytes;
+
+	if (hdr == NULL) {
+		printk("no flash simulator statistics\n");
+		return 0;
+	}
+
+	stats_walk(hdr, flash_stat_find, NULL);
+
+	/* Start from an empty directory, nothing has been logged yet */
+	(void)log_files(true);
+
+	for (int i = 0; i < ARRAY_SIZE(flash_stats); i++) {
+		start[i] = *flash_stats[i].value;
+	}
+
+	start_ms = k_uptime_get();
+
+	for (int i = 0; i < N_MSGS; i++) {
+		while (log_buffered_cnt() > MAX_PENDING) {
+			k_msleep(1);
+		}
+
+		LOG_INF("message %d, with a few more bytes of payload", i);
+	}
+
+	while (log_data_pending()) {
+		k_msleep(1);
+	}
+
+	(void)log_backend_fs_flush();
+
+	elapsed_ms = MAX(k_uptime_get() - start_ms, 1);
+
+	/* Let the processing thread finish writing the last message */
+	k_msleep(100);
+	bytes = log_files(false);
+
+	printk("%s%s: %u bytes/s, %u flash writes, %u flash erases, "
+	       "%u bytes programmed for %u bytes of logs\n",
+	       IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY) ? "dictionary, " : "",
+	       IS_ENABLED(CONFIG_LOG_BACKEND_FS_BUFFERED) ? "buffered" : "unbuffered",
+	       (uint32_t)(bytes * MSEC_PER_SEC / elapsed_ms),
+	       *flash_stats[1].value - start[1], *flash_stats[2].value - start[2],
+	       *flash_stats[0].value - start[0], (uint32_t)bytes);
+
+	printk("fin\n");
+	return 0;
+}
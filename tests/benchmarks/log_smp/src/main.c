@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_msg.h>
+
+/* Measure how the cost of deferred logging scales with the number of
+ * CPUs.  For 1 to N threads, with N the number of CPUs, each thread calls
+ * LOG_INF() in a loop for a fixed time, while the log processing thread
+ * hands the messages to a backend which only counts them.  The total
+ * number of LOG_INF() calls per second, the average time of a call, the
+ * share of dropped messages and the number of messages processed out of
+ * timestamp order are reported.
+ */
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define N_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE 1024
+#define RUN_MS 1000
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct worker {
+	struct k_thread thread;
+	uint32_t ops;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct worker workers[N_THREADS];
+static atomic_t stop;
+
+static uint32_t processed;
+static uint32_t unordered;
+static log_timestamp_t last_timestamp;
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	log_timestamp_t timestamp = log_msg_get_timestamp(&msg->log);
+
+	ARG_UNUSED(backend);
+
+	if (timestamp < last_timestamp) {
+		unordered++;
+	}
+
+	last_timestamp = timestamp;
+	processed++;
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, backend_api, true);
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!atomic_get(&stop)) {
+		LOG_INF("worker %p message %u", w, w->ops);
+		w->ops++;
+	}
+}
+
+static void measure(int n_threads)
+{
+	uint32_t ops = 0U;
+	uint32_t dropped, ns;
+
+	atomic_clear(&stop);
+	processed = 0U;
+	unordered = 0U;
+
+	for (int i = 0; i < n_threads; i++) {
+		workers[i].ops = 0U;
+		k_thread_create(&workers[i].thread, stacks[i], STACK_SIZE,
+				worker_fn, &workers[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(RUN_MS);
+	atomic_set(&stop, 1);
+
+	for (int i = 0; i < n_threads; i++) {
+		k_thread_join(&workers[i].thread, K_FOREVER);
+		ops += workers[i].ops;
+	}
+
+	/* Let the processing thread empty the buffers */
+	while (log_data_pending()) {
+		k_msleep(10);
+	}
+	k_msleep(10);
+
+	/* Every call logs one message, the missing ones were dropped */
+	dropped = ops - MIN(processed, ops);
+	ops = MAX(ops, 1U);
+	ns = (uint32_t)((uint64_t)n_threads * RUN_MS * NSEC_PER_MSEC / ops);
+
+	printk("cpus %2d: %8u ops/s, %6u ns/call, %3u%% dropped, %u unordered\n",
+	       n_threads, (uint32_t)((uint64_t)ops * MSEC_PER_SEC / RUN_MS), ns,
+	       (uint32_t)((uint64_t)dropped * 100U / ops), unordered);
+}
+
+int main(void)
+{
+	/* Only preempted to take the measurements */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	printk("Deferred logging throughput, %s\n",
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFER) ? "per-CPU buffers" :
+						       "single buffer");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		measure(n);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+
+/* Measure how the memory slab alloc/free throughput scales with the
+ * number of CPUs.  For 1 to N threads, with N the number of CPUs, each
+ * thread allocates a few blocks from a shared slab and frees them, in a
+ * loop, for a fixed time, and the total number of operations per second
+ * is reported.  Holding a few blocks at once makes the blocks go back and
+ * forth between the slab and the per-CPU caches when they are enabled.
+ */
+
+#define N_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE 1024
+#define SETTLE_MS 100
+#define RUN_MS 1000
+
+#define BLOCK_SIZE 64
+#define BLOCKS_HELD 4
+#define N_BLOCKS (N_THREADS * BLOCKS_HELD * 4)
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, N_BLOCKS, 8);
+
+struct worker {
+	struct k_thread thread;
+	atomic_t ops;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct worker workers[N_THREADS];
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+	void *blocks[BLOCKS_HELD];
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		for (int i = 0; i < BLOCKS_HELD; i++) {
+			if (k_mem_slab_alloc(&slab, &blocks[i], K_FOREVER) != 0) {
+				printk("alloc failed\n");
+				return;
+			}
+		}
+
+		for (int i = 0; i < BLOCKS_HELD; i++) {
+			k_mem_slab_free(&slab, blocks[i]);
+		}
+
+		atomic_add(&w->ops, 2 * BLOCKS_HELD);
+	}
+}
+
+static uint32_t total_ops(int n_threads)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < n_threads; i++) {
+		total += (uint32_t)atomic_get(&workers[i].ops);
+	}
+
+	return total;
+}
+
+static uint32_t measure(int n_threads)
+{
+	uint32_t start, end;
+
+	for (int i = 0; i < n_threads; i++) {
+		atomic_clear(&workers[i].ops);
+		k_thread_create(&workers[i].thread, stacks[i], STACK_SIZE,
+				worker_fn, &workers[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(SETTLE_MS);
+	start = total_ops(n_threads);
+	k_msleep(RUN_MS);
+	end = total_ops(n_threads);
+
+	for (int i = 0; i < n_threads; i++) {
+		k_thread_abort(&workers[i].thread);
+	}
+
+	return (uint64_t)(end - start) * MSEC_PER_SEC / RUN_MS;
+}
+
+int main(void)
+{
+	/* Only preempted to take the measurements */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	printk("Memory slab alloc/free throughput, %s\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_PER_CPU_CACHE) ? "per-CPU caches" :
+							    "no cache");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		printk("cpus %2d: %8u ops/s\n", n, measure(n));
+
+		/* The aborted threads may have held blocks */
+		k_mem_slab_init(&slab, slab.buffer, BLOCK_SIZE, N_BLOCKS);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+
+/* Measure how the throughput of a contended mutex scales with the
+ * number of CPUs.  For 1 to N threads, with N the number of CPUs, each
+ * thread locks a shared mutex, updates a few shared words and unlocks
+ * it, in a loop, for a fixed time, and the total number of lock/unlock
+ * pairs per second is reported.  The critical section is much shorter
+ * than a context switch, which is the case adaptive spinning is for.
+ */
+
+#define N_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE 1024
+#define SETTLE_MS 100
+#define RUN_MS 1000
+
+#define SHARED_WORDS 8
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+K_MUTEX_DEFINE(mutex);
+
+struct worker {
+	struct k_thread thread;
+	atomic_t ops;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct worker workers[N_THREADS];
+static uint32_t shared[SHARED_WORDS];
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		if (k_mutex_lock(&mutex, K_FOREVER) != 0) {
+			printk("lock failed\n");
+			return;
+		}
+
+		for (int i = 0; i < SHARED_WORDS; i++) {
+			shared[i]++;
+		}
+
+		k_mutex_unlock(&mutex);
+
+		atomic_inc(&w->ops);
+	}
+}
+
+static uint32_t total_ops(int n_threads)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < n_threads; i++) {
+		total += (uint32_t)atomic_get(&workers[i].ops);
+	}
+
+	return total;
+}
+
+static uint32_t measure(int n_threads)
+{
+	uint32_t start, end;
+
+	for (int i = 0; i < n_threads; i++) {
+		atomic_clear(&workers[i].ops);
+		k_thread_create(&workers[i].thread, stacks[i], STACK_SIZE,
+				worker_fn, &workers[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(SETTLE_MS);
+	start = total_ops(n_threads);
+	k_msleep(RUN_MS);
+	end = total_ops(n_threads);
+
+	for (int i = 0; i < n_threads; i++) {
+		k_thread_abort(&workers[i].thread);
+	}
+
+	return (uint64_t)(end - start) * MSEC_PER_SEC / RUN_MS;
+}
+
+int main(void)
+{
+	/* Only preempted to take the measurements */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	printk("Contended mutex lock/unlock throughput, %s\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "adaptive spinning" :
+							 "no spinning");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		printk("cpus %2d: %8u ops/s\n", n, measure(n));
+
+		/* The aborted threads may have held the mutex */
+		k_mutex_init(&mutex);
+	}
+
+	printk("fin\n");
+	return 0;
+}
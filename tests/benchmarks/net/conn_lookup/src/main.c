@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of finding the receiving connection handler for an
+ * UDP packet as a function of the number of registered handlers.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "bench_clock.h"
+#include "net_private.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+#include "connection.h"
+
+#define LOOKUPS 2000
+#define BASE_PORT 5000
+#define PEER_PORT 4242
+
+static const uint16_t sock_counts[] = { 1, 8, 32, 64, 128, 256 };
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static uint32_t delivered;
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api dummy_if_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(conn_bench, "conn_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict bench_cb(struct net_conn *conn,
+				 struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 union net_proto_header *proto_hdr,
+				 void *user_data)
+{
+	/* Keep the packet so that it can be looked up again */
+	delivered++;
+
+	return NET_OK;
+}
+
+static void register_handler(int idx)
+{
+	struct sockaddr_in6 local = { 0 };
+	int ret;
+
+	local.sin6_family = AF_INET6;
+	local.sin6_port = htons(BASE_PORT + idx);
+	net_ipaddr_copy(&local.sin6_addr, &my_addr);
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET6, NULL,
+				(struct sockaddr *)&local, 0,
+				BASE_PORT + idx, NULL, bench_cb, NULL,
+				&handles[idx]);
+	zassert_equal(ret, 0, "Cannot register handler %d (%d)", idx, ret);
+}
+
+static uint32_t measure(struct net_if *iface, uint16_t dst_port)
+{
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	struct net_pkt *pkt;
+	uint64_t start, end;
+
+	pkt = net_pkt_alloc_with_buffer(iface, 0, AF_INET6, IPPROTO_UDP,
+					K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+
+	zassert_ok(net_ipv6_create(pkt, &peer_addr, &my_addr));
+	zassert_ok(net_udp_create(pkt, htons(PEER_PORT), htons(dst_port)));
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv6_finalize(pkt, IPPROTO_UDP));
+
+	/* Both headers are in the first fragment */
+	ip_hdr.ipv6 = (struct net_ipv6_hdr *)pkt->buffer->data;
+	proto_hdr.udp = (struct net_udp_hdr *)(pkt->buffer->data +
+					       sizeof(struct net_ipv6_hdr));
+
+	delivered = 0U;
+
+	start = bench_clock_ns();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	end = bench_clock_ns();
+
+	zassert_equal(delivered, LOOKUPS, "Packet not delivered (%u)",
+		      delivered);
+
+	net_pkt_unref(pkt);
+
+	return (uint32_t)((end - start) / LOOKUPS);
+}
+
+ZTEST(conn_lookup, test_udp_lookup)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	int registered = 0;
+
+	zassert_not_null(net_if_ipv6_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0));
+
+	bench_clock_init();
+
+	TC_PRINT("UDP connection lookup, %s\n",
+		 IS_ENABLED(CONFIG_NET_CONN_HASH) ? "hashed" : "linear");
+
+	for (int i = 0; i < ARRAY_SIZE(sock_counts); i++) {
+		while (registered < sock_counts[i]) {
+			register_handler(registered++);
+		}
+
+		/* The first handler is the last one in the registration
+		 * order, i.e. the worst case for the linear lookup.
+		 */
+		TC_PRINT("sockets %4d: %6u ns/lookup\n", registered,
+			 measure(iface, BASE_PORT));
+	}
+
+	for (int i = 0; i < registered; i++) {
+		zassert_ok(net_conn_unregister(handles[i]));
+	}
+
+	TC_PRINT("conn_lookup done\n");
+}
+
+ZTEST_SUITE(conn_lookup, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of finding the route to a destination as a function
+ * of the number of routes in the routing table.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/dummy.h>
+
+#include "bench_clock.h"
+#include "net_private.h"
+#include "ipv6.h"
+#include "route.h"
+
+#define LOOKUPS 2000
+
+static const uint16_t route_counts[] = { 1, 8, 32, 64, 128, 256 };
+
+static struct net_route_entry *routes[CONFIG_NET_MAX_ROUTES];
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api dummy_if_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(route_bench, "route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* Prefix 2001:db8:<idx>::/48, the host part is kept in dst */
+static void route_prefix(int idx, struct in6_addr *prefix)
+{
+	net_ipaddr_copy(prefix, &my_addr);
+	prefix->s6_addr16[2] = htons(idx + 1);
+}
+
+static void add_route(struct net_if *iface, int idx)
+{
+	struct in6_addr prefix;
+
+	route_prefix(idx, &prefix);
+
+	routes[idx] = net_route_add(iface, &prefix, 48, &peer_addr,
+				    NET_IPV6_ND_INFINITE_LIFETIME,
+				    NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(routes[idx], "Cannot add route %d", idx);
+}
+
+static uint32_t measure(struct net_if *iface, int idx)
+{
+	struct net_route_entry *route;
+	struct in6_addr dst;
+	uint64_t start, end;
+
+	route_prefix(idx, &dst);
+
+	start = bench_clock_ns();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		route = net_route_lookup(iface, &dst);
+	}
+
+	end = bench_clock_ns();
+
+	zassert_equal_ptr(route, routes[idx], "Invalid route");
+
+	return (uint32_t)((end - start) / LOOKUPS);
+}
+
+ZTEST(route_lookup, test_route_lookup)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_linkaddr lladdr = {
+		.addr = (uint8_t[]){ 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 },
+		.len = 6,
+		.type = NET_LINK_ETHERNET,
+	};
+	int added = 0;
+
+	zassert_not_null(net_if_ipv6_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0));
+	zassert_not_null(net_ipv6_nbr_add(iface, &peer_addr, &lladdr, false,
+					  NET_IPV6_NBR_STATE_REACHABLE),
+			 "Cannot add neighbor");
+
+	bench_clock_init();
+
+	TC_PRINT("IPv6 route lookup, %s%s\n",
+		 IS_ENABLED(CONFIG_NET_ROUTE_LPM) ? "trie" : "linear",
+		 CONFIG_NET_ROUTE_CACHE_SIZE > 0 ? " with cache" : "");
+
+	for (int i = 0; i < ARRAY_SIZE(route_counts); i++) {
+		while (added < route_counts[i]) {
+			add_route(iface, added++);
+		}
+
+		/* The most recently added route is the last one in the
+		 * lookup order, i.e. the worst case for the linear lookup.
+		 */
+		TC_PRINT("routes %4d: %6u ns/lookup\n", added,
+			 measure(iface, added - 1));
+	}
+
+	for (int i = 0; i < added; i++) {
+		zassert_ok(net_route_del(routes[i]));
+	}
+
+	TC_PRINT("route_lookup done\n");
+}
+
+ZTEST_SUITE(route_lookup, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compare the cost of waiting for one readable socket out of many with
+ * zsock_poll(), which registers every descriptor on each call, and with
+ * zsock_epoll_wait(), which only looks at the descriptors that reported
+ * readiness.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#include "bench_clock.h"
+
+#define ROUNDS 200
+#define BASE_PORT 5000
+#define PEER_PORT 4242
+
+static const uint16_t sock_counts[] = { 1, 8, 32, 64, 128 };
+
+static int socks[128];
+static struct zsock_pollfd pollfds[ARRAY_SIZE(socks)];
+static int peer = -1;
+static int epfd = -1;
+
+static void bind_sock(int sock, uint16_t port)
+{
+	struct sockaddr_in6 addr = { 0 };
+
+	addr.sin6_family = AF_INET6;
+	addr.sin6_port = htons(port);
+	addr.sin6_addr = in6addr_loopback;
+
+	zassert_ok(zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "bind failed (%d)", errno);
+}
+
+static void add_sock(int idx)
+{
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN,
+		.data.fd = idx,
+	};
+
+	socks[idx] = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(socks[idx] >= 0, "socket %d failed (%d)", idx, errno);
+
+	bind_sock(socks[idx], BASE_PORT + idx);
+
+	pollfds[idx].fd = socks[idx];
+	pollfds[idx].events = ZSOCK_POLLIN;
+
+	zassert_ok(zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, socks[idx], &ev),
+		   "epoll_ctl failed (%d)", errno);
+}
+
+/* The datagram goes to the last socket, i.e. the worst case for the scan */
+static void send_to(int idx)
+{
+	struct sockaddr_in6 addr = { 0 };
+	char byte = 0;
+
+	addr.sin6_family = AF_INET6;
+	addr.sin6_port = htons(BASE_PORT + idx);
+	addr.sin6_addr = in6addr_loopback;
+
+	zassert_equal(zsock_sendto(peer, &byte, sizeof(byte), 0,
+				   (struct sockaddr *)&addr, sizeof(addr)),
+		      sizeof(byte), "send failed (%d)", errno);
+}
+
+static void recv_from(int idx)
+{
+	char byte;
+
+	zassert_equal(zsock_recv(socks[idx], &byte, sizeof(byte), 0),
+		      sizeof(byte), "recv failed (%d)", errno);
+}
+
+static uint32_t measure_poll(int count)
+{
+	uint64_t total = 0;
+	uint64_t start;
+	int ret;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		send_to(count - 1);
+
+		start = bench_clock_ns();
+		ret = zsock_poll(pollfds, count, 1000);
+		total += bench_clock_ns() - start;
+
+		zassert_equal(ret, 1, "poll failed (%d)", ret);
+		zassert_equal(pollfds[count - 1].revents, ZSOCK_POLLIN);
+
+		recv_from(count - 1);
+	}
+
+	return (uint32_t)(total / ROUNDS);
+}
+
+static uint32_t measure_epoll(int count)
+{
+	struct zsock_epoll_event ev;
+	uint64_t total = 0;
+	uint64_t start;
+	int ret;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		send_to(count - 1);
+
+		start = bench_clock_ns();
+		ret = zsock_epoll_wait(epfd, &ev, 1, 1000);
+		total += bench_clock_ns() - start;
+
+		zassert_equal(ret, 1, "epoll_wait failed (%d)", ret);
+		zassert_equal(ev.data.fd, count - 1);
+
+		recv_from(count - 1);
+	}
+
+	/* Drop the level triggered entry left over from the last round */
+	zassert_equal(zsock_epoll_wait(epfd, &ev, 1, 0), 0);
+
+	return (uint32_t)(total / ROUNDS);
+}
+
+ZTEST(socket_epoll, test_wait_one_of_many)
+{
+	int added = 0;
+
+	bench_clock_init();
+
+	peer = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(peer >= 0, "socket failed (%d)", errno);
+	bind_sock(peer, PEER_PORT);
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	TC_PRINT("Wait for 1 readable UDP socket out of N\n");
+
+	for (int i = 0; i < ARRAY_SIZE(sock_counts); i++) {
+		while (added < sock_counts[i]) {
+			add_sock(added++);
+		}
+
+		TC_PRINT("sockets %4d: poll %7u ns/wait, epoll %7u ns/wait\n",
+			 added, measure_poll(added), measure_epoll(added));
+	}
+
+	zassert_ok(zsock_close(epfd));
+
+	for (int i = 0; i < added; i++) {
+		zassert_ok(zsock_close(socks[i]));
+	}
+
+	zassert_ok(zsock_close(peer));
+
+	TC_PRINT("socket_epoll done\n");
+}
+
+ZTEST_SUITE(socket_epoll, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the TCP send throughput over the native_sim Ethernet driver
+ * (eth_native_posix), with and without generic segmentation offload.
+ *
+ * The peer is the host side of the zeth TAP interface, set up with the
+ * net-setup.sh script of the net-tools project, and must discard the
+ * received data, for example:
+ *
+ *   nc -l -k 192.0.2.2 4242 > /dev/null
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#include "bench_clock.h"
+
+#define PEER_PORT 4242
+#define CHUNK_LEN (8 * 1460)
+#define TOTAL_LEN (32 * 1024 * 1024)
+
+static uint8_t chunk[CHUNK_LEN];
+
+ZTEST(tcp_gso, test_send_throughput)
+{
+	struct sockaddr_in addr = { 0 };
+	uint64_t elapsed;
+	uint64_t start;
+	size_t total = 0;
+	ssize_t ret;
+	int sock;
+
+	bench_clock_init();
+
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(PEER_PORT);
+	zassert_equal(zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_PEER_IPV4_ADDR,
+				      &addr.sin_addr), 1);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket failed (%d)", errno);
+
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "connect failed (%d)", errno);
+
+	for (size_t i = 0; i < sizeof(chunk); i++) {
+		chunk[i] = (uint8_t)i;
+	}
+
+	start = bench_clock_ns();
+
+	while (total < TOTAL_LEN) {
+		ret = zsock_send(sock, chunk, MIN(sizeof(chunk), TOTAL_LEN - total), 0);
+		zassert_true(ret > 0, "send failed (%d)", errno);
+
+		total += ret;
+	}
+
+	elapsed = bench_clock_ns() - start;
+
+	zassert_ok(zsock_close(sock));
+
+	TC_PRINT("GSO %s: %zu bytes in %llu ms, %llu kB/s\n",
+		 IS_ENABLED(CONFIG_NET_TCP_GSO) ? "enabled" : "disabled",
+		 total, elapsed / NSEC_PER_MSEC,
+		 (uint64_t)total * NSEC_PER_SEC / 1024U / MAX(elapsed, 1U));
+
+	TC_PRINT("tcp_gso done\n");
+}
+
+ZTEST_SUITE(tcp_gso, NULL, NULL, NULL, NULL, NULL);
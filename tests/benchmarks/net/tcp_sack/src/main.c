@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure a TCP transfer over a lossy link, with and without selective
+ * acknowledgements.
+ *
+ * Both ends use the loopback interface, which drops one packet in
+ * 1 / DROP_RATIO in both directions. The link time is the kernel uptime,
+ * which includes the retransmission timeouts (on native_sim they take no
+ * host time at all), the CPU time is measured with the benchmark clock.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+
+#include "bench_clock.h"
+
+#define SERVER_PORT 4242
+#define CHUNK_LEN 1024
+#define TOTAL_LEN (256 * 1024)
+#define DROP_RATIO 0.02f
+
+static uint8_t tx_chunk[CHUNK_LEN];
+static uint8_t rx_chunk[CHUNK_LEN];
+static size_t received;
+
+static K_THREAD_STACK_DEFINE(server_stack, 2048);
+static struct k_thread server_thread;
+
+static void server_entry(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	ssize_t ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (received < TOTAL_LEN) {
+		ret = zsock_recv(sock, rx_chunk, sizeof(rx_chunk), 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		received += ret;
+	}
+}
+
+ZTEST(tcp_sack, test_lossy_transfer)
+{
+	struct sockaddr_in addr = { 0 };
+	struct net_stats_tcp before;
+	struct net_stats_tcp after;
+	uint64_t cpu_ns;
+	int64_t link_ms;
+	size_t total = 0;
+	int server;
+	int client;
+	int peer;
+	ssize_t ret;
+
+	bench_clock_init();
+
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(SERVER_PORT);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	server = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(server >= 0, "socket failed (%d)", errno);
+	zassert_ok(zsock_bind(server, (struct sockaddr *)&addr, sizeof(addr)),
+		   "bind failed (%d)", errno);
+	zassert_ok(zsock_listen(server, 1), "listen failed (%d)", errno);
+
+	client = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(client >= 0, "socket failed (%d)", errno);
+	zassert_ok(zsock_connect(client, (struct sockaddr *)&addr, sizeof(addr)),
+		   "connect failed (%d)", errno);
+
+	peer = zsock_accept(server, NULL, NULL);
+	zassert_true(peer >= 0, "accept failed (%d)", errno);
+
+	for (size_t i = 0; i < sizeof(tx_chunk); i++) {
+		tx_chunk[i] = (uint8_t)i;
+	}
+
+	k_thread_create(&server_thread, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack), server_entry,
+			INT_TO_POINTER(peer), NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &before, sizeof(before));
+
+	/* Only the data transfer is lossy, not the connection setup */
+	zassert_ok(loopback_set_packet_drop_ratio(DROP_RATIO));
+
+	link_ms = k_uptime_get();
+	cpu_ns = bench_clock_ns();
+
+	while (total < TOTAL_LEN) {
+		ret = zsock_send(client, tx_chunk,
+				 MIN(sizeof(tx_chunk), TOTAL_LEN - total), 0);
+		zassert_true(ret > 0, "send failed (%d)", errno);
+
+		total += ret;
+	}
+
+	zassert_ok(k_thread_join(&server_thread, K_SECONDS(60)),
+		   "receiver did not finish");
+
+	cpu_ns = bench_clock_ns() - cpu_ns;
+	link_ms = k_uptime_get() - link_ms;
+
+	zassert_ok(loopback_set_packet_drop_ratio(0.0f));
+
+	net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &after, sizeof(after));
+
+	zassert_equal(received, TOTAL_LEN, "received %zu bytes", received);
+
+	zassert_ok(zsock_close(peer));
+	zassert_ok(zsock_close(client));
+	zassert_ok(zsock_close(server));
+
+	TC_PRINT("SACK %s: %zu bytes, %d packets dropped, %u segments resent, "
+		 "link %lld ms, CPU %llu ms\n",
+		 IS_ENABLED(CONFIG_NET_TCP_SACK) ? "enabled" : "disabled",
+		 total, loopback_get_num_dropped_packets(),
+		 (unsigned int)(after.rexmit - before.rexmit),
+		 link_ms, cpu_ns / NSEC_PER_MSEC);
+
+	TC_PRINT("tcp_sack done\n");
+}
+
+ZTEST_SUITE(tcp_sack, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of a dispatcher thread waiting on many semaphores,
+ * with k_poll() registering all the events on every call against a
+ * k_poll_set registering them once.  A lower priority producer gives the
+ * semaphores in turn, so that every wait pends the dispatcher and is
+ * woken up by one event.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "bench_clock.h"
+
+#define MAX_EVENTS 64
+#define N_ROUNDS 1000
+#define STACK_SIZE 1024
+
+static const uint8_t event_counts[] = { 1, 8, 64 };
+
+static struct k_sem sems[MAX_EVENTS];
+static struct k_poll_event events[MAX_EVENTS];
+static struct k_poll_set set;
+
+static struct k_thread producer;
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+
+static void producer_fn(void *p1, void *p2, void *p3)
+{
+	int count = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		/* The last semaphores are the worst case for k_poll() */
+		k_sem_give(&sems[count - 1 - (i % count)]);
+	}
+}
+
+static void start_producer(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+	}
+
+	k_thread_create(&producer, producer_stack, STACK_SIZE, producer_fn,
+			INT_TO_POINTER(count), NULL, NULL,
+			k_thread_priority_get(k_current_get()) + 1, 0, K_NO_WAIT);
+}
+
+static uint32_t bench_poll(int count)
+{
+	uint64_t start, end;
+
+	start_producer(count);
+	start = bench_clock_ns();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		zassert_ok(k_poll(events, count, K_FOREVER));
+
+		for (int j = 0; j < count; j++) {
+			if (events[j].state != K_POLL_STATE_NOT_READY) {
+				events[j].state = K_POLL_STATE_NOT_READY;
+				zassert_ok(k_sem_take(&sems[j], K_NO_WAIT));
+			}
+		}
+	}
+
+	end = bench_clock_ns();
+	k_thread_join(&producer, K_FOREVER);
+
+	return (uint32_t)((end - start) / N_ROUNDS);
+}
+
+static uint32_t bench_poll_set(int count)
+{
+	struct k_poll_event *ready[MAX_EVENTS];
+	uint64_t start, end;
+
+	start_producer(count);
+	k_poll_set_init(&set, events, count);
+	start = bench_clock_ns();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		int n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_FOREVER);
+
+		zassert_true(n > 0, "wait failed (%d)", n);
+
+		for (int j = 0; j < n; j++) {
+			zassert_ok(k_sem_take(ready[j]->sem, K_NO_WAIT));
+		}
+	}
+
+	end = bench_clock_ns();
+	k_thread_join(&producer, K_FOREVER);
+	k_poll_set_clear(&set);
+
+	return (uint32_t)((end - start) / N_ROUNDS);
+}
+
+ZTEST(poll_set, test_wait)
+{
+	bench_clock_init();
+
+	TC_PRINT("Waiting on N semaphores, one given per wait\n");
+
+	for (int c = 0; c < ARRAY_SIZE(event_counts); c++) {
+		int count = event_counts[c];
+		uint32_t poll_ns = bench_poll(count);
+		uint32_t set_ns = bench_poll_set(count);
+
+		TC_PRINT("events %2d: k_poll %7u ns, k_poll_set %7u ns\n", count,
+			 poll_ns, set_ns);
+	}
+
+	TC_PRINT("poll_set done\n");
+}
+
+ZTEST_SUITE(poll_set, NULL, NULL, NULL, NULL, NULL);
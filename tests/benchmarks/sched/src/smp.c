@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+
+/* This is the SMP variant of the scheduler benchmark, measuring how the
+ * context switch throughput scales with the number of CPUs instead of
+ * the latency of each step.  Pairs of threads ping-pong through two
+ * semaphores, so that every round pends one thread and readies the
+ * other one:
+ *
+ * 1. Thread A gives the semaphore of thread B and takes its own
+ * 2. Thread B wakes up, gives the semaphore of thread A and takes its own
+ *
+ * For 1 to N pairs, with N the number of CPUs, the pairs run for a fixed
+ * time and the total number of switches per second is reported.  With a
+ * scheduler that scales, the throughput grows with the number of pairs.
+ */
+
+#define N_PAIRS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE 1024
+#define SETTLE_MS 100
+#define RUN_MS 1000
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct worker {
+	struct k_thread thread;
+	struct k_sem sem;
+	struct worker *partner;
+	atomic_t switches;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * N_PAIRS, STACK_SIZE);
+static struct worker workers[2 * N_PAIRS];
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_give(&w->partner->sem);
+		k_sem_take(&w->sem, K_FOREVER);
+		atomic_inc(&w->switches);
+	}
+}
+
+static uint32_t total_switches(int n_workers)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < n_workers; i++) {
+		total += (uint32_t)atomic_get(&workers[i].switches);
+	}
+
+	return total;
+}
+
+static uint32_t measure(int n_pairs)
+{
+	int n_workers = 2 * n_pairs;
+	uint32_t start, end;
+
+	for (int i = 0; i < n_workers; i++) {
+		struct worker *w = &workers[i];
+
+		k_sem_init(&w->sem, 0, 1);
+		w->partner = &workers[i ^ 1];
+		atomic_clear(&w->switches);
+	}
+
+	/* The second thread of each pair waits for the first one */
+	for (int i = n_workers - 1; i >= 0; i--) {
+		k_thread_create(&workers[i].thread, stacks[i], STACK_SIZE,
+				worker_fn, &workers[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(SETTLE_MS);
+	start = total_switches(n_workers);
+	k_msleep(RUN_MS);
+	end = total_switches(n_workers);
+
+	for (int i = 0; i < n_workers; i++) {
+		k_thread_abort(&workers[i].thread);
+	}
+
+	return (uint64_t)(end - start) * MSEC_PER_SEC / RUN_MS;
+}
+
+int main(void)
+{
+	/* Only preempted to take the measurements */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	printk("Context switch throughput, %s run queue\n",
+	       IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ) ? "per-CPU" : "global");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		printk("cpus %2d: %8u switches/s\n", n, measure(n));
+	}
+
+	printk("fin\n");
+	return 0;
+}
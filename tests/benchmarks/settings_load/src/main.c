@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/settings/settings.h>
+
+#include "bench_clock.h"
+
+/* Measure the time settings_load() takes with many static handlers and
+ * keys, as with Bluetooth bonds or per peer configuration, from NVS on the
+ * flash simulator.  The time spent looking up the handlers of the keys,
+ * included in the load time, is also measured alone.
+ */
+
+#define N_HANDLERS 64
+#define N_KEYS 1000
+#define N_LOADS 4
+#define N_LOOKUPS 100
+#define MAX_NAME_LEN 16
+
+static uint32_t set_calls;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+
+	if (read_cb(cb_arg, &val, sizeof(val)) == sizeof(val)) {
+		set_calls++;
+	}
+
+	return 0;
+}
+
+#define BENCH_HANDLER(i, _) \
+	SETTINGS_STATIC_HANDLER_DEFINE(bench_##i, "h" STRINGIFY(i), NULL, \
+				       bench_set, NULL, NULL)
+
+LISTIFY(N_HANDLERS, BENCH_HANDLER, (;));
+
+static char names[N_KEYS][MAX_NAME_LEN];
+
+int main(void)
+{
+	uint64_t start, ns;
+	int rc;
+
+	rc = settings_subsys_init();
+	if (rc != 0) {
+		printk("settings init failed (%d)\n", rc);
+		return 0;
+	}
+
+	/* Keys spread over the handlers, one level below them */
+	for (uint32_t i = 0; i < N_KEYS; i++) {
+		snprintf(names[i], sizeof(names[i]), "h%u/p%u", i % N_HANDLERS,
+			 i / N_HANDLERS);
+
+		rc = settings_save_one(names[i], &i, sizeof(i));
+		if (rc != 0) {
+			printk("save failed (%d)\n", rc);
+			return 0;
+		}
+	}
+
+	bench_clock_init();
+
+	start = bench_clock_ns();
+	for (int i = 0; i < N_LOADS; i++) {
+		(void)settings_load();
+	}
+	ns = bench_clock_ns() - start;
+
+	if (set_calls != N_KEYS * N_LOADS) {
+		printk("%u keys loaded, expected %u\n", set_calls, N_KEYS * N_LOADS);
+	}
+
+	printk("settings_load: %u us for %u keys, %u handlers\n",
+	       (uint32_t)(ns / NSEC_PER_USEC / N_LOADS), N_KEYS, N_HANDLERS);
+
+	start = bench_clock_ns();
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		for (int j = 0; j < N_KEYS; j++) {
+			(void)settings_parse_and_lookup(names[j], NULL);
+		}
+	}
+	ns = bench_clock_ns() - start;
+
+	printk("lookup: %u ns/key\n",
+	       (uint32_t)(ns / (N_LOOKUPS * N_KEYS)));
+
+	printk("fin\n");
+	return 0;
+}
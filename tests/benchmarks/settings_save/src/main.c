@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/stats/stats.h>
+
+/* Measure the time to save a new setting, update a stored one and delete
+ * one, with NVS on the flash simulator, as the number of stored settings
+ * grows.  The number of flash reads per update is also reported.
+ */
+
+#define N_OPS 20
+#define MAX_NAME_LEN 16
+
+static const uint32_t n_keys[] = { 100, 250, 500, 1000 };
+
+static uint32_t *flash_read_calls;
+
+static int flash_stat_find(struct stats_hdr *hdr, void *arg,
+			   const char *name, uint16_t off)
+{
+	ARG_UNUSED(arg);
+
+	if (strcmp(name, "flash_read_calls") == 0) {
+		flash_read_calls = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t save_us(const char *prefix, uint32_t first, uint32_t step,
+			bool delete)
+{
+	char name[MAX_NAME_LEN];
+	uint32_t start, cycles = 0;
+	int rc;
+
+	for (uint32_t i = 0; i < N_OPS; i++) {
+		uint32_t val = first + i * step;
+
+		snprintf(name, sizeof(name), "%s/%u", prefix, val);
+
+		start = k_cycle_get_32();
+		if (delete) {
+			rc = settings_delete(name);
+		} else {
+			rc = settings_save_one(name, &val, sizeof(val));
+		}
+		cycles += k_cycle_get_32() - start;
+
+		if (rc != 0) {
+			printk("%s %s failed (%d)\n", delete ? "delete" : "save", name, rc);
+		}
+	}
+
+	return (uint32_t)(k_cyc_to_us_floor64(cycles) / N_OPS);
+}
+
+int main(void)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	char name[MAX_NAME_LEN];
+	uint32_t stored = 0;
+	uint32_t new_us, update_us, delete_us, reads;
+	int rc;
+
+	if (hdr == NULL) {
+		printk("no flash simulator statistics\n");
+		return 0;
+	}
+
+	stats_walk(hdr, flash_stat_find, NULL);
+
+	rc = settings_subsys_init();
+	if (rc != 0) {
+		printk("settings init failed (%d)\n", rc);
+		return 0;
+	}
+
+	for (int n = 0; n < ARRAY_SIZE(n_keys); n++) {
+		for (; stored < n_keys[n]; stored++) {
+			snprintf(name, sizeof(name), "k/%u", stored);
+
+			rc = settings_save_one(name, &stored, sizeof(stored));
+			if (rc != 0) {
+				printk("save failed (%d)\n", rc);
+				return 0;
+			}
+		}
+
+		new_us = save_us("n", 0, 1, false);
+
+		reads = *flash_read_calls;
+		update_us = save_us("k", 0, stored / N_OPS, false);
+		reads = *flash_read_calls - reads;
+
+		delete_us = save_us("n", 0, 1, true);
+
+		printk("keys %4u: new %u us, update %u us, delete %u us, "
+		       "%u flash reads per update\n",
+		       stored, new_us, update_us, delete_us, reads / N_OPS);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of adding and aborting kernel timeouts as a function
+ * of the number of active timeouts.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <timeout_q.h>
+
+#include "bench_clock.h"
+
+#define N_TIMEOUTS 10000
+
+/* Far enough for none of the timeouts to expire during the benchmark */
+#define BASE_DELAY K_SECONDS(3600)
+#define DELAY_SPREAD 100000
+
+static const uint16_t timeout_counts[] = { 10, 100, 1000, 10000 };
+
+static struct _timeout timeouts[N_TIMEOUTS];
+static uint32_t delays[N_TIMEOUTS];
+
+static void timeout_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	ztest_test_fail();
+}
+
+static k_timeout_t timeout_delay(int idx)
+{
+	return K_TICKS(BASE_DELAY.ticks + delays[idx]);
+}
+
+ZTEST(timeout_queue, test_add_abort)
+{
+	uint32_t seed = 1U;
+	uint64_t start, end;
+
+	/* Random delays, as sorted ones would make the list either very
+	 * fast or very slow.
+	 */
+	for (int i = 0; i < N_TIMEOUTS; i++) {
+		seed = seed * 1103515245U + 12345U;
+		delays[i] = (seed >> 8) % DELAY_SPREAD;
+		z_init_timeout(&timeouts[i]);
+	}
+
+	bench_clock_init();
+
+	TC_PRINT("Kernel timeout queue, %s\n",
+		 IS_ENABLED(CONFIG_TIMEOUT_WHEEL) ? "timing wheel" : "sorted list");
+
+	for (int c = 0; c < ARRAY_SIZE(timeout_counts); c++) {
+		int count = timeout_counts[c];
+		uint32_t add_ns, abort_ns;
+
+		start = bench_clock_ns();
+
+		for (int i = 0; i < count; i++) {
+			z_add_timeout(&timeouts[i], timeout_fn, timeout_delay(i));
+		}
+
+		end = bench_clock_ns();
+		add_ns = (uint32_t)((end - start) / count);
+
+		/* Abort in another order than they were added */
+		start = bench_clock_ns();
+
+		for (int i = 0; i < count; i++) {
+			int idx = (i * 7919) % count;
+
+			zassert_ok(z_abort_timeout(&timeouts[idx]),
+				   "Timeout %d not active", idx);
+		}
+
+		end = bench_clock_ns();
+		abort_ns = (uint32_t)((end - start) / count);
+
+		TC_PRINT("timeouts %5d: add %6u ns, abort %6u ns\n", count,
+			 add_ns, abort_ns);
+	}
+
+	TC_PRINT("timeout_queue done\n");
+}
+
+ZTEST_SUITE(timeout_queue, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of posting bursts of work items, as a driver posting
+ * many completions at once, submitted one by one or as a batch, to a work
+ * queue in the default mode or in batch mode.  The submitting thread has
+ * a higher priority than the work queue, so the submission time is the
+ * cost for the submitter (the latency added to an ISR) and the completion
+ * time, up to the last item done, is the throughput of the queue.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "bench_clock.h"
+
+#define BURST 32
+#define N_ROUNDS 200
+#define STACK_SIZE 1024
+#define QUEUE_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_DEFINE(default_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(batch_stack, STACK_SIZE);
+static struct k_work_q default_queue;
+static struct k_work_q batch_queue;
+
+static struct k_work works[BURST];
+static struct k_work *batch[BURST];
+static K_SEM_DEFINE(done, 0, 1);
+static int handled;
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (++handled == BURST) {
+		handled = 0;
+		k_sem_give(&done);
+	}
+}
+
+static void bench(struct k_work_q *queue, bool batched, uint32_t *submit_ns,
+		  uint32_t *done_ns)
+{
+	uint64_t submit = 0, total = 0;
+
+	for (int r = 0; r < N_ROUNDS; r++) {
+		uint64_t start = bench_clock_ns();
+
+		if (batched) {
+			zassert_equal(k_work_submit_batch_to_queue(queue, batch, BURST),
+				      BURST);
+		} else {
+			for (int i = 0; i < BURST; i++) {
+				zassert_equal(k_work_submit_to_queue(queue, &works[i]), 1);
+			}
+		}
+
+		uint64_t submitted = bench_clock_ns();
+
+		k_sem_take(&done, K_FOREVER);
+		submit += submitted - start;
+		total += bench_clock_ns() - start;
+
+		/* The last item is finished by the queue once idle */
+		k_msleep(1);
+	}
+
+	*submit_ns = (uint32_t)(submit / (N_ROUNDS * BURST));
+	*done_ns = (uint32_t)(total / (N_ROUNDS * BURST));
+}
+
+ZTEST(work_batch, test_burst)
+{
+	struct k_work_queue_config cfg = { .name = "default" };
+	uint32_t submit_ns, done_ns;
+
+	bench_clock_init();
+
+	k_work_queue_start(&default_queue, default_stack, STACK_SIZE, QUEUE_PRIO, &cfg);
+	cfg.name = "batch";
+	cfg.batch = true;
+	k_work_queue_start(&batch_queue, batch_stack, STACK_SIZE, QUEUE_PRIO, &cfg);
+
+	for (int i = 0; i < BURST; i++) {
+		k_work_init(&works[i], work_handler);
+		batch[i] = &works[i];
+	}
+
+	TC_PRINT("Bursts of %d work items, per item\n", BURST);
+
+	for (int q = 0; q < 2; q++) {
+		struct k_work_q *queue = (q == 0) ? &default_queue : &batch_queue;
+
+		for (int b = 0; b < 2; b++) {
+			bench(queue, b != 0, &submit_ns, &done_ns);
+			TC_PRINT("queue %-7s submit %-6s: submit %6u ns, done %6u ns\n",
+				 (q == 0) ? "default" : "batch", (b == 0) ? "single" : "batch",
+				 submit_ns, done_ns);
+		}
+	}
+
+	TC_PRINT("work_batch done\n");
+}
+
+ZTEST_SUITE(work_batch, NULL, NULL, NULL, NULL, NULL);
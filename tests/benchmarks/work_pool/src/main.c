@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Measure how the throughput of a work pool scales with the number of
+ * workers.  For pools of 1 to N workers, with N the number of CPUs, a
+ * burst of CPU bound work items is submitted from one thread, which then
+ * waits for all of them to complete, in a loop, for a fixed time, and the
+ * number of items completed per second is reported.  All the items go to
+ * the queue of the submitting CPU, so they are spread over the workers
+ * only by the idle ones taking them.
+ */
+
+#define N_CPUS CONFIG_MP_MAX_NUM_CPUS
+#define N_WORKERS (N_CPUS * (N_CPUS + 1) / 2)
+#define STACK_SIZE 1024
+#define RUN_MS 1000
+
+#define BURST 64
+#define ITEM_LOOPS 2000
+
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_WORKERS, STACK_SIZE);
+static struct k_work_q queues[N_WORKERS];
+static struct k_work_pool pools[N_CPUS];
+
+static struct k_work items[BURST];
+static K_SEM_DEFINE(done, 0, BURST);
+static volatile uint32_t sink;
+
+static void item_handler(struct k_work *work)
+{
+	uint32_t x = POINTER_TO_UINT(work);
+
+	for (int i = 0; i < ITEM_LOOPS; i++) {
+		x = x * 1103515245U + 12345U;
+	}
+
+	sink = x;
+	k_sem_give(&done);
+}
+
+static uint32_t measure(struct k_work_pool *pool)
+{
+	struct k_work_sync sync;
+	uint32_t count = 0U;
+	int64_t start = k_uptime_get();
+
+	while (k_uptime_get() - start < RUN_MS) {
+		for (int i = 0; i < BURST; i++) {
+			(void)k_work_pool_submit(pool, &items[i]);
+		}
+
+		for (int i = 0; i < BURST; i++) {
+			k_sem_take(&done, K_FOREVER);
+		}
+
+		count += BURST;
+	}
+
+	/* The items may still be finishing on the workers of this pool */
+	for (int i = 0; i < BURST; i++) {
+		(void)k_work_flush(&items[i], &sync);
+	}
+
+	return (uint64_t)count * MSEC_PER_SEC / (k_uptime_get() - start);
+}
+
+int main(void)
+{
+	int first = 0;
+
+	/* Not preempted by the workers while submitting a burst */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	for (int i = 0; i < BURST; i++) {
+		k_work_init(&items[i], item_handler);
+	}
+
+	printk("Work pool throughput, %d items per burst\n", BURST);
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		k_work_pool_start(&pools[n - 1], &queues[first], n,
+				  &stacks[first][0], STACK_SIZE, WORKER_PRIO, NULL);
+		first += n;
+
+		printk("workers %2d: %8u items/s\n", n, measure(&pools[n - 1]));
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -460,6 +460,58 @@ ZTEST(mutex_api_1cpu, test_mutex_timeout_race_during_priority_inversion)
 	k_mutex_unlock(&tmutex);
 }
 
+#define CONTENDED_LOCKS 1000
+
+static int contended_count;
+
+static void tThread_contended(void *p1, void *p2, void *p3)
+{
+	struct k_mutex *mutex = (struct k_mutex *)p1;
+
+	for (int i = 0; i < CONTENDED_LOCKS; i++) {
+		zassert_ok(k_mutex_lock(mutex, K_FOREVER));
+
+		int count = contended_count;
+
+		/* Keep the mutex long enough for the others to wait on it */
+		k_busy_wait(1);
+		contended_count = count + 1;
+
+		zassert_ok(k_mutex_unlock(mutex));
+	}
+}
+
+/**
+ * @brief Test mutual exclusion between threads contending on a mutex
+ *
+ * Three threads lock a mutex in a loop to increment a counter.  With
+ * CONFIG_MUTEX_ADAPTIVE_SPIN on SMP they run on different CPUs and spin
+ * on the mutex held by each other, and pend when the owner is preempted.
+ *
+ * @ingroup kernel_mutex_tests
+ *
+ * @see k_mutex_lock(), k_mutex_unlock()
+ */
+ZTEST(mutex_api, test_mutex_contended)
+{
+	k_mutex_init(&tmutex);
+	contended_count = 0;
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_contended,
+			&tmutex, NULL, NULL, THREAD_LOW_PRIORITY, 0, K_NO_WAIT);
+	k_thread_create(&tdata2, tstack2, STACK_SIZE, tThread_contended,
+			&tmutex, NULL, NULL, THREAD_LOW_PRIORITY, 0, K_NO_WAIT);
+	k_thread_create(&tdata3, tstack3, STACK_SIZE, tThread_contended,
+			&tmutex, NULL, NULL, THREAD_LOW_PRIORITY, 0, K_NO_WAIT);
+
+	k_thread_join(&tdata, K_FOREVER);
+	k_thread_join(&tdata2, K_FOREVER);
+	k_thread_join(&tdata3, K_FOREVER);
+
+	zassert_equal(contended_count, 3 * CONTENDED_LOCKS);
+	zassert_is_null(tmutex.owner);
+}
+
 static void *mutex_api_tests_setup(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define NUM_SEMS 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_sem set_sems[NUM_SEMS];
+static struct k_poll_signal set_signal;
+static struct k_poll_event set_events[NUM_SEMS + 1];
+static struct k_poll_set set;
+
+static struct k_thread set_thread;
+K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void set_setup(void)
+{
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		set_events[i].tag = i;
+	}
+
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&set_events[NUM_SEMS], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+	set_events[NUM_SEMS].tag = NUM_SEMS;
+
+	k_poll_set_init(&set, set_events, ARRAY_SIZE(set_events));
+}
+
+/**
+ * @brief Test that a poll set only returns the events that occurred
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready_subset)
+{
+	struct k_poll_event *ready[NUM_SEMS + 1];
+	int n;
+
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT),
+		      -EAGAIN, "nothing should be ready");
+
+	k_sem_give(&set_sems[2]);
+	k_sem_give(&set_sems[5]);
+	k_poll_signal_raise(&set_signal, 0);
+
+	n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(n, 3, "expected 3 ready events, got %d", n);
+	zassert_equal(ready[0]->tag, 2);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(ready[1]->tag, 5);
+	zassert_equal(ready[1]->state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(ready[2]->tag, NUM_SEMS);
+	zassert_equal(ready[2]->state, K_POLL_STATE_SIGNALED);
+
+	zassert_ok(k_sem_take(&set_sems[2], K_NO_WAIT));
+	zassert_ok(k_sem_take(&set_sems[5], K_NO_WAIT));
+	k_poll_signal_reset(&set_signal);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT),
+		      -EAGAIN, "events should have been consumed");
+
+	k_poll_set_clear(&set);
+}
+
+/**
+ * @brief Test that a returned event is returned again while its object
+ * is still available, and that events not fitting are kept for later
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_rearm)
+{
+	struct k_poll_event *ready[2];
+	int n;
+
+	set_setup();
+
+	k_sem_give(&set_sems[0]);
+	k_sem_give(&set_sems[1]);
+	k_sem_give(&set_sems[7]);
+
+	n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(n, 2, "expected 2 ready events, got %d", n);
+	zassert_equal(ready[0]->tag, 0);
+	zassert_equal(ready[1]->tag, 1);
+
+	/* Only the first semaphore is taken */
+	zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+
+	n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(n, 2, "expected 2 ready events, got %d", n);
+	zassert_equal(ready[0]->tag, 7);
+	zassert_equal(ready[1]->tag, 1);
+
+	zassert_ok(k_sem_take(&set_sems[1], K_NO_WAIT));
+	zassert_ok(k_sem_take(&set_sems[7], K_NO_WAIT));
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT),
+		      -EAGAIN, "events should have been consumed");
+
+	k_poll_set_clear(&set);
+}
+
+static void set_give_helper(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_give(p1);
+}
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait(), k_poll_set_clear()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[NUM_SEMS + 1];
+	int n;
+
+	set_setup();
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_give_helper, &set_sems[4], NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(50));
+
+	n = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_FOREVER);
+	zassert_equal(n, 1, "expected 1 ready event, got %d", n);
+	zassert_equal(ready[0]->tag, 4);
+	zassert_ok(k_sem_take(&set_sems[4], K_NO_WAIT));
+
+	k_thread_join(&set_thread, K_FOREVER);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(50)),
+		      -EAGAIN, "wait should have timed out");
+
+	/* The events are free to be used with k_poll() again */
+	k_poll_set_clear(&set);
+
+	k_sem_give(&set_sems[3]);
+	set_events[3].state = K_POLL_STATE_NOT_READY;
+	zassert_ok(k_poll(&set_events[3], 1, K_NO_WAIT));
+	zassert_equal(set_events[3].state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_ok(k_sem_take(&set_sems[3], K_NO_WAIT));
+}
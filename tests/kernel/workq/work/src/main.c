@@ -120,6 +120,10 @@ static inline int preempt_counter(void)
 static K_THREAD_STACK_DEFINE(invalid_test_stack, STACK_SIZE);
 static struct k_work_q invalid_test_queue;
 
+static K_THREAD_STACK_DEFINE(batch_stack, STACK_SIZE);
+static struct k_work_q batch_queue;
+static atomic_t batch_ctr;
+
 static atomic_t system_ctr;
 static inline int system_counter(void)
 {
@@ -267,6 +271,14 @@ static void test_queue_start(void)
 			    COOPLO_PRIORITY, &cfg);
 	zassert_equal(cooplo_queue.flags,
 		      K_WORK_QUEUE_STARTED | K_WORK_QUEUE_NO_YIELD, NULL);
+
+	cfg.name = "wq.batch";
+	cfg.no_yield = false;
+	cfg.batch = true;
+	k_work_queue_start(&batch_queue, batch_stack, STACK_SIZE,
+			    COOPHI_PRIORITY, &cfg);
+	zassert_equal(batch_queue.flags,
+		      K_WORK_QUEUE_STARTED | K_WORK_QUEUE_BATCH, NULL);
 }
 
 /* Check validation of submission without a destination queue. */
@@ -313,6 +325,68 @@ ZTEST(work_1cpu, test_1cpu_simple_queue)
 	zassert_equal(rc, 0);
 }
 
+/* Single-CPU check of the submission of several items at once. */
+ZTEST(work_1cpu, test_1cpu_batch_submit)
+{
+	struct k_work *works[] = { &common_work, &common_work1, &common_work };
+	int rc;
+
+	reset_counters();
+	k_work_init(&common_work, counter_handler);
+	k_work_init(&common_work1, counter_handler);
+
+	/* The second submission of the first item is a no-op */
+	rc = k_work_submit_batch_to_queue(&coophi_queue, works, ARRAY_SIZE(works));
+	zassert_equal(rc, 2);
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_QUEUED);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_QUEUED);
+	zassert_equal(coophi_counter(), 0);
+
+	/* Let them run, then check they finished. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), 2);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+
+	/* Flush the sync state from completion, given by both */
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), 0);
+
+	/* A rejecting queue rejects the whole batch */
+	rc = k_work_submit_batch_to_queue(&not_start_queue, works, 2);
+	zassert_equal(rc, -ENODEV);
+}
+
+static void batch_handler(struct k_work *work)
+{
+	zassert_equal(k_current_get(), &batch_queue.thread);
+	atomic_inc(&batch_ctr);
+}
+
+/* Single-CPU check of a queue running its items in batch. */
+ZTEST(work_1cpu, test_1cpu_batch_queue)
+{
+	static struct k_work works[4];
+	struct k_work *batch[ARRAY_SIZE(works)];
+	int rc;
+
+	atomic_clear(&batch_ctr);
+	for (int i = 0; i < ARRAY_SIZE(works); i++) {
+		k_work_init(&works[i], batch_handler);
+		batch[i] = &works[i];
+	}
+
+	rc = k_work_submit_batch_to_queue(&batch_queue, batch, ARRAY_SIZE(batch));
+	zassert_equal(rc, ARRAY_SIZE(batch));
+
+	/* The items complete when the queue takes the next one */
+	zassert_true(k_work_flush(&works[ARRAY_SIZE(works) - 1], &work_sync));
+	zassert_equal(atomic_get(&batch_ctr), ARRAY_SIZE(works));
+
+	for (int i = 0; i < ARRAY_SIZE(works); i++) {
+		zassert_equal(k_work_busy_get(&works[i]), 0);
+	}
+}
+
 /* Basic SMP check submitting with a non-blocking handler. */
 ZTEST(work, test_smp_simple_queue)
 {
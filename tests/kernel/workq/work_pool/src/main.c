@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/atomic.h>
+
+#define NUM_WORKERS 2
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAIT_TIMEOUT K_MSEC(100)
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q pool_queues[NUM_WORKERS];
+static struct k_work_pool pool;
+
+static K_THREAD_STACK_DEFINE(flush_stack, STACK_SIZE);
+static struct k_thread flush_thread;
+
+/* A work item blocking in its handler until released */
+struct test_item {
+	struct k_work work;
+	struct k_sem release;
+	k_tid_t thread;
+	atomic_t runs;
+};
+
+static struct test_item items[3];
+static struct k_sem started;
+static atomic_t running;
+
+static void item_handler(struct k_work *work)
+{
+	struct test_item *item = CONTAINER_OF(work, struct test_item, work);
+
+	item->thread = k_current_get();
+	atomic_inc(&running);
+	k_sem_give(&started);
+
+	k_sem_take(&item->release, K_FOREVER);
+
+	atomic_dec(&running);
+	atomic_inc(&item->runs);
+}
+
+/* Submit an item and wait for it to be running */
+static void start_item(struct test_item *item)
+{
+	zassert_equal(k_work_pool_submit(&pool, &item->work), 1);
+	zassert_ok(k_sem_take(&started, WAIT_TIMEOUT), "item not started");
+}
+
+static void finish_item(struct test_item *item)
+{
+	struct k_work_sync sync;
+
+	k_sem_give(&item->release);
+	(void)k_work_flush(&item->work, &sync);
+}
+
+/* Item A runs on a worker, B on the other one, C is left pending on the
+ * queue of A.
+ */
+static void start_items(void)
+{
+	start_item(&items[0]);
+	start_item(&items[1]);
+	zassert_equal(k_work_pool_submit(&pool, &items[2].work), 1);
+}
+
+/**
+ * @brief Test that an idle worker takes the work of a busy one
+ *
+ * @see k_work_pool_submit()
+ */
+ZTEST(work_pool_1cpu, test_steal)
+{
+	start_item(&items[0]);
+	start_item(&items[1]);
+
+	zassert_equal(atomic_get(&running), 2, "items not run in parallel");
+	zassert_not_equal(items[0].thread, items[1].thread);
+
+	finish_item(&items[0]);
+	finish_item(&items[1]);
+	zassert_equal(atomic_get(&items[0].runs), 1);
+	zassert_equal(atomic_get(&items[1].runs), 1);
+}
+
+/**
+ * @brief Test that resubmitting a running item queues it on its worker
+ *
+ * @see k_work_pool_submit()
+ */
+ZTEST(work_pool_1cpu, test_resubmit_running)
+{
+	start_item(&items[0]);
+
+	zassert_equal(k_work_pool_submit(&pool, &items[0].work), 2);
+	zassert_equal(k_work_pool_submit(&pool, &items[0].work), 0);
+
+	k_sem_give(&items[0].release);
+	zassert_ok(k_sem_take(&started, WAIT_TIMEOUT), "item not restarted");
+	finish_item(&items[0]);
+	zassert_equal(atomic_get(&items[0].runs), 2);
+}
+
+static void flush_fn(void *p1, void *p2, void *p3)
+{
+	struct k_work_sync sync;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_true(k_work_flush(p1, &sync));
+}
+
+/**
+ * @brief Test that flushing an item taken by another worker waits for it
+ *
+ * @see k_work_pool_submit(), k_work_flush()
+ */
+ZTEST(work_pool_1cpu, test_flush_stolen)
+{
+	start_items();
+
+	/* The flusher is queued after C, on the queue of A */
+	k_thread_create(&flush_thread, flush_stack, STACK_SIZE, flush_fn,
+			&items[2].work, NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	/* The worker of B takes C and its flusher while A is still busy */
+	k_sem_give(&items[2].release);
+	k_sem_give(&items[1].release);
+	zassert_ok(k_thread_join(&flush_thread, WAIT_TIMEOUT), "flush not done");
+
+	zassert_equal(atomic_get(&items[2].runs), 1);
+	zassert_equal(items[2].thread, items[1].thread);
+	zassert_equal(atomic_get(&running), 1);
+
+	finish_item(&items[0]);
+}
+
+/**
+ * @brief Test that a pending item of a pool can be cancelled
+ *
+ * @see k_work_pool_submit(), k_work_cancel()
+ */
+ZTEST(work_pool_1cpu, test_cancel_pending)
+{
+	start_items();
+
+	zassert_equal(k_work_cancel(&items[2].work), 0);
+
+	finish_item(&items[0]);
+	finish_item(&items[1]);
+	k_msleep(10);
+
+	zassert_equal(atomic_get(&items[2].runs), 0);
+	zassert_equal(k_work_busy_get(&items[2].work), 0);
+}
+
+static void *work_pool_setup(void)
+{
+	/* The workers preempt the test thread as soon as work is submitted */
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+
+	k_work_pool_start(&pool, pool_queues, NUM_WORKERS, &pool_stacks[0][0],
+			  STACK_SIZE, prio, NULL);
+
+	return NULL;
+}
+
+static void work_pool_before(void *fixture)
+{
+	ztest_simple_1cpu_before(fixture);
+
+	k_sem_init(&started, 0, ARRAY_SIZE(items));
+	atomic_clear(&running);
+
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i].work, item_handler);
+		k_sem_init(&items[i].release, 0, 2);
+		items[i].thread = NULL;
+		atomic_clear(&items[i].runs);
+	}
+}
+
+ZTEST_SUITE(work_pool_1cpu, NULL, work_pool_setup, work_pool_before,
+	    ztest_simple_1cpu_after, NULL);
@@ -154,10 +154,18 @@ static void log_result(size_t sz, struct z_heap_stress_result *r)
 	uint32_t succ_pct = ((100ULL * r->successful_allocs + r->total_allocs / 2)
 			  / r->total_allocs);
 
+	uint64_t cycles = r->total_alloc_cycles + r->total_free_cycles;
+	uint32_t ops_per_sec = cycles == 0 ? 0 :
+		(uint32_t)((uint64_t)tot * sys_clock_hw_cycles_per_sec() / cycles);
+
 	TC_PRINT("successful allocs: %d/%d (%d%%), frees: %d,"
 		 "  avg usage: %d/%d (%d%%)\n",
 		 r->successful_allocs, r->total_allocs, succ_pct,
 		 r->total_frees, avg, (int) sz, avg_pct);
+	TC_PRINT("alloc cycles: p50 %u, p90 %u, p99 %u, max %u,"
+		 "  alloc+free ops/s: %u\n",
+		 r->alloc_cycles_p50, r->alloc_cycles_p90,
+		 r->alloc_cycles_p99, r->alloc_cycles_max, ops_per_sec);
 }
 
 /* Do a heavy test over a small heap, with many iterations that need
@@ -238,6 +246,43 @@ ZTEST(lib_heap, test_big_heap)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+void *test_k_heap_alloc(void *arg, size_t bytes)
+{
+	void *ret = k_heap_alloc(arg, bytes, K_NO_WAIT);
+
+	fill_block(ret, bytes);
+	return ret;
+}
+
+void test_k_heap_free(void *arg, void *p)
+{
+	check_fill(p);
+	k_heap_free(arg, p);
+}
+
+/* The same small heap workload through the k_heap API, which has the
+ * lock and, with CONFIG_HEAP_PER_CPU_CACHE, the per-CPU caches of small
+ * blocks in front of the sys_heap.  Compare the latencies and the
+ * throughput with the scenario without the caches.
+ */
+ZTEST(lib_heap, test_k_heap)
+{
+	static struct k_heap heap;
+	struct z_heap_stress_result result;
+
+	TC_PRINT("Testing small (%d byte) k_heap%s\n", (int) SMALL_HEAP_SZ,
+		 IS_ENABLED(CONFIG_HEAP_PER_CPU_CACHE) ? " with per-CPU caches" : "");
+
+	k_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_stress(test_k_heap_alloc, test_k_heap_free, &heap,
+			SMALL_HEAP_SZ, ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			50, &result);
+	zassert_true(sys_heap_validate(&heap.heap), "");
+
+	log_result(SMALL_HEAP_SZ, &result);
+}
+
 /* Test a heap with a solo free header.  A solo free header can exist
  * only on a heap with 64 bit CPU (or chunk_header_bytes() == 8).
  * With 64 bytes heap and 1 byte allocation on a big heap, we get:
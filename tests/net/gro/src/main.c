@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "connection.h"
+#include "net_gro.h"
+
+#define MY_PORT 4242
+#define PEER_PORT 4243
+
+#define SEG_LEN 100
+#define ACK_SEQ 1000
+
+#define TH_PSH 0x08
+#define TH_ACK 0x10
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_if *iface;
+static struct net_conn_handle *handle;
+static struct net_gro gro;
+
+static int delivered;
+static size_t rx_len;
+static uint8_t rx_data[8 * SEG_LEN];
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api dummy_if_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(gro_test, "gro_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict tcp_cb(struct net_conn *conn,
+			       struct net_pkt *pkt,
+			       union net_ip_header *ip_hdr,
+			       union net_proto_header *proto_hdr,
+			       void *user_data)
+{
+	size_t len = net_pkt_remaining_data(pkt);
+
+	zassert_true(rx_len + len <= sizeof(rx_data), "Too much data");
+	zassert_ok(net_pkt_read(pkt, rx_data + rx_len, len), "Cannot read");
+
+	rx_len += len;
+	delivered++;
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_pkt *create_segment(uint32_t seq, size_t len, uint8_t flags)
+{
+	struct net_tcp_hdr hdr = { 0 };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, len, AF_INET6, IPPROTO_TCP,
+					K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+
+	hdr.src_port = htons(PEER_PORT);
+	hdr.dst_port = htons(MY_PORT);
+	sys_put_be32(seq, hdr.seq);
+	sys_put_be32(ACK_SEQ, hdr.ack);
+	hdr.offset = (sizeof(hdr) / 4) << 4;
+	hdr.flags = flags;
+	sys_put_be16(1024, hdr.wnd);
+
+	zassert_ok(net_ipv6_create(pkt, &peer_addr, &my_addr));
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)));
+
+	/* The payload is the low byte of the sequence number of each byte */
+	for (size_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, (uint8_t)(seq + i)));
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv6_finalize(pkt, IPPROTO_TCP));
+
+	/* As the driver would give it to net_recv_data() */
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void check_data(uint32_t seq, size_t len)
+{
+	zassert_equal(rx_len, len, "Received %zu bytes instead of %zu",
+		      rx_len, len);
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(rx_data[i], (uint8_t)(seq + i),
+			      "Invalid data at %zu", i);
+	}
+}
+
+ZTEST(net_gro, test_merge_in_order)
+{
+	for (int i = 0; i < 3; i++) {
+		net_gro_receive(&gro, create_segment(i * SEG_LEN, SEG_LEN,
+						     i == 2 ? TH_ACK | TH_PSH : TH_ACK));
+	}
+
+	zassert_equal(delivered, 0, "Segments not held");
+
+	net_gro_flush(&gro);
+
+	zassert_equal(delivered, 1, "Segments not merged (%d)", delivered);
+	check_data(0, 3 * SEG_LEN);
+}
+
+ZTEST(net_gro, test_max_segments)
+{
+	for (int i = 0; i < CONFIG_NET_GRO_MAX_SEGMENTS + 1; i++) {
+		net_gro_receive(&gro, create_segment(i * SEG_LEN, SEG_LEN, TH_ACK));
+	}
+
+	zassert_equal(delivered, 1, "Full packet not passed up");
+
+	net_gro_flush(&gro);
+
+	zassert_equal(delivered, 2, "Invalid packet count (%d)", delivered);
+	check_data(0, (CONFIG_NET_GRO_MAX_SEGMENTS + 1) * SEG_LEN);
+}
+
+ZTEST(net_gro, test_out_of_order)
+{
+	net_gro_receive(&gro, create_segment(0, SEG_LEN, TH_ACK));
+	net_gro_receive(&gro, create_segment(2 * SEG_LEN, SEG_LEN, TH_ACK));
+
+	/* The first segment is passed up before the next one is held */
+	zassert_equal(delivered, 1, "Invalid packet count (%d)", delivered);
+
+	net_gro_flush(&gro);
+
+	zassert_equal(delivered, 2, "Invalid packet count (%d)", delivered);
+}
+
+ZTEST(net_gro, test_odd_length)
+{
+	/* The payload of the second segment would start at an odd offset */
+	net_gro_receive(&gro, create_segment(0, SEG_LEN + 1, TH_ACK));
+	net_gro_receive(&gro, create_segment(SEG_LEN + 1, SEG_LEN, TH_ACK));
+	net_gro_flush(&gro);
+
+	zassert_equal(delivered, 2, "Invalid packet count (%d)", delivered);
+	check_data(0, 2 * SEG_LEN + 1);
+}
+
+ZTEST(net_gro, test_not_mergeable_flags)
+{
+	net_gro_receive(&gro, create_segment(0, SEG_LEN, TH_ACK));
+
+	/* A pure ACK is passed up right away, after the held data */
+	net_gro_receive(&gro, create_segment(SEG_LEN, 0, TH_ACK));
+
+	zassert_equal(delivered, 2, "Invalid packet count (%d)", delivered);
+
+	net_gro_flush(&gro);
+
+	zassert_equal(delivered, 2, "Invalid packet count (%d)", delivered);
+	check_data(0, SEG_LEN);
+}
+
+ZTEST(net_gro, test_corrupted_segment)
+{
+	struct net_pkt *pkt;
+
+	net_gro_receive(&gro, create_segment(0, SEG_LEN, TH_ACK));
+
+	/* Flip a payload byte after the checksum was computed */
+	pkt = create_segment(SEG_LEN, SEG_LEN, TH_ACK);
+	zassert_ok(net_pkt_skip(pkt, NET_IPV6H_LEN + sizeof(struct net_tcp_hdr)));
+	zassert_ok(net_pkt_write_u8(pkt, 0xaa ^ (uint8_t)SEG_LEN));
+	net_pkt_cursor_init(pkt);
+
+	net_gro_receive(&gro, pkt);
+	net_gro_flush(&gro);
+
+	/* The checksum of the merged packet is not valid either */
+	zassert_equal(delivered, 0, "Corrupted data delivered");
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in6 local = { 0 };
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No interface");
+
+	zassert_not_null(net_if_ipv6_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0));
+
+	local.sin6_family = AF_INET6;
+	local.sin6_port = htons(MY_PORT);
+	net_ipaddr_copy(&local.sin6_addr, &my_addr);
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET6, NULL,
+				(struct sockaddr *)&local, 0, MY_PORT, NULL,
+				tcp_cb, NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register handler (%d)", ret);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	delivered = 0;
+	rx_len = 0;
+}
+
+ZTEST_SUITE(net_gro, NULL, setup, before, NULL, NULL);
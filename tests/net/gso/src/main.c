@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "net_gso.h"
+
+#define SEG_LEN 500
+#define DATA_LEN (3 * SEG_LEN + 10)
+#define BASE_SEQ 1000
+
+#define TH_PSH 0x08
+#define TH_ACK 0x10
+
+#define MAX_FRAMES 8
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+struct frame {
+	uint32_t seq;
+	uint8_t flags;
+	uint16_t chksum;
+	uint16_t gso_size;
+	size_t len;
+};
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context;
+static struct net_if *eth_iface;
+static bool tso;
+
+static struct frame frames[MAX_FRAMES];
+static int frame_count;
+static uint8_t rx_data[DATA_LEN];
+
+static int eth_send(const struct device *dev, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct frame *frame;
+
+	ARG_UNUSED(dev);
+
+	zassert_true(frame_count < MAX_FRAMES, "Too many frames");
+	frame = &frames[frame_count++];
+
+	zassert_ok(net_pkt_pull(pkt, sizeof(struct net_eth_hdr)));
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	frame->gso_size = net_pkt_gso_size(pkt);
+	frame->chksum = net_calc_chksum_tcp(pkt);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_skip(pkt, NET_IPV6H_LEN));
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "No TCP header");
+
+	frame->seq = sys_get_be32(tcp_hdr->seq);
+	frame->flags = tcp_hdr->flags;
+
+	zassert_ok(net_pkt_skip(pkt, sizeof(struct net_tcp_hdr)));
+	frame->len = net_pkt_remaining_data(pkt);
+
+	zassert_true(frame->seq - BASE_SEQ + frame->len <= sizeof(rx_data),
+		     "Invalid segment");
+	zassert_ok(net_pkt_read(pkt, &rx_data[frame->seq - BASE_SEQ],
+				frame->len));
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_get_capabilities(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return tso ? ETHERNET_HW_TSO : 0;
+}
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+	static const uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	memcpy(context->mac_addr, mac, sizeof(mac));
+
+	return 0;
+}
+
+static struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_get_capabilities,
+	.send = eth_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_gso_test, "eth_gso_test", eth_init, NULL,
+		    &eth_context, NULL, CONFIG_ETH_INIT_PRIORITY, &eth_api,
+		    NET_ETH_MTU);
+
+/* Build a TCP packet carrying DATA_LEN bytes, as TCP does with GSO */
+static struct net_pkt *create_gso_pkt(uint8_t flags)
+{
+	struct net_tcp_hdr hdr = { 0 };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_on_iface(eth_iface, K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+
+	zassert_ok(net_pkt_alloc_buffer_raw(pkt, NET_IPV6H_LEN + sizeof(hdr) +
+					    DATA_LEN, K_SECONDS(1)));
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_gso_size(pkt, SEG_LEN);
+	net_pkt_lladdr_src(pkt)->addr = net_if_get_link_addr(eth_iface)->addr;
+	net_pkt_lladdr_src(pkt)->len = net_if_get_link_addr(eth_iface)->len;
+
+	hdr.src_port = htons(4242);
+	hdr.dst_port = htons(4243);
+	sys_put_be32(BASE_SEQ, hdr.seq);
+	sys_put_be32(1, hdr.ack);
+	hdr.offset = (sizeof(hdr) / 4) << 4;
+	hdr.flags = flags;
+	sys_put_be16(1024, hdr.wnd);
+
+	zassert_ok(net_ipv6_create(pkt, &my_addr, &peer_addr));
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)));
+
+	for (size_t i = 0; i < DATA_LEN; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, (uint8_t)i));
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv6_finalize(pkt, IPPROTO_TCP));
+
+	return pkt;
+}
+
+ZTEST(net_gso, test_software_segmentation)
+{
+	struct net_pkt *pkt = create_gso_pkt(TH_ACK | TH_PSH);
+	int ret;
+
+	ret = net_gso_send(eth_iface, pkt);
+	zassert_true(ret > 0, "Send failed (%d)", ret);
+
+	zassert_equal(frame_count, 4, "Invalid frame count (%d)", frame_count);
+
+	for (int i = 0; i < frame_count; i++) {
+		zassert_equal(frames[i].seq, BASE_SEQ + i * SEG_LEN,
+			      "Invalid seq in frame %d", i);
+		zassert_equal(frames[i].len, i < 3 ? SEG_LEN : 10,
+			      "Invalid length of frame %d", i);
+		zassert_equal(frames[i].flags,
+			      i < 3 ? TH_ACK : TH_ACK | TH_PSH,
+			      "Invalid flags in frame %d", i);
+		zassert_equal(frames[i].chksum, 0,
+			      "Invalid checksum in frame %d", i);
+		zassert_equal(frames[i].gso_size, 0,
+			      "Frame %d is a GSO packet", i);
+	}
+
+	for (size_t i = 0; i < DATA_LEN; i++) {
+		zassert_equal(rx_data[i], (uint8_t)i, "Invalid data at %zu", i);
+	}
+}
+
+ZTEST(net_gso, test_tso)
+{
+	struct net_pkt *pkt = create_gso_pkt(TH_ACK);
+	int ret;
+
+	tso = true;
+
+	ret = net_gso_send(eth_iface, pkt);
+	zassert_true(ret > 0, "Send failed (%d)", ret);
+
+	/* The driver gets the whole packet, and segments it itself */
+	zassert_equal(frame_count, 1, "Invalid frame count (%d)", frame_count);
+	zassert_equal(frames[0].len, DATA_LEN, "Invalid length");
+	zassert_equal(frames[0].gso_size, SEG_LEN, "Invalid GSO size");
+}
+
+static void *setup(void)
+{
+	eth_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(eth_iface, "No interface");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	tso = false;
+	frame_count = 0;
+	memset(rx_data, 0, sizeof(rx_data));
+}
+
+ZTEST_SUITE(net_gso, NULL, setup, before, NULL, NULL);
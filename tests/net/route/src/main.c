@@ -544,6 +544,63 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct in6_addr prefix32 = { { { 0x20, 0x01, 0x0d, 0xb8 } } };
+	struct in6_addr in_prefix64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0x12, 0x34 } } };
+	struct in6_addr in_prefix32 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 1, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0x12, 0x34 } } };
+	struct in6_addr other = { { { 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0,
+				      0, 0, 0, 0, 0, 0, 0x12, 0x34 } } };
+	struct net_route_entry *route32, *route64, *route128;
+
+	route32 = net_route_add(my_iface, &prefix32, 32, &peer_addr,
+				NET_IPV6_ND_INFINITE_LIFETIME,
+				NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route32, "Route add failed");
+
+	/* The more specific routes do not replace the covering one */
+	route64 = net_route_add(my_iface, &prefix32, 64, &peer_addr_alt,
+				NET_IPV6_ND_INFINITE_LIFETIME,
+				NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route64, "Route add failed");
+
+	route128 = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route128, "Route add failed");
+
+	/* Twice, so that the second lookup may come from the route cache */
+	for (int i = 0; i < 2; i++) {
+		zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr),
+				  route128, "Invalid route for /128");
+		zassert_equal_ptr(net_route_lookup(my_iface, &in_prefix64),
+				  route64, "Invalid route for /64");
+		zassert_equal_ptr(net_route_lookup(NULL, &in_prefix32),
+				  route32, "Invalid route for /32");
+		zassert_is_null(net_route_lookup(my_iface, &other),
+				"Route found for other prefix");
+		zassert_is_null(net_route_lookup(peer_iface, &dest_addr),
+				"Route found on other interface");
+	}
+
+	zassert_ok(net_route_del(route64), "Route del failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_prefix64),
+			  route32, "Deleted route still used");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr),
+			  route128, "Invalid route for /128");
+
+	zassert_ok(net_route_del(route32), "Route del failed");
+
+	zassert_is_null(net_route_lookup(my_iface, &in_prefix32),
+			"Deleted route still used");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr),
+			  route128, "Invalid route for /128");
+
+	zassert_ok(net_route_del(route128), "Route del failed");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +623,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait takes +10ms from the requested time. */
+#define FUZZ 10
+
+static int c_sock;
+static int s_sock;
+static int epfd;
+
+static void setup_socks(void)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed");
+}
+
+static void teardown_socks(void)
+{
+	zassert_ok(zsock_close(epfd));
+	zassert_ok(zsock_close(c_sock));
+	zassert_ok(zsock_close(s_sock));
+}
+
+static void epoll_add(int fd, uint32_t events)
+{
+	struct zsock_epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	zassert_ok(zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fd, &ev),
+		   "epoll_ctl failed (%d)", errno);
+}
+
+ZTEST(net_socket_epoll, test_epoll_level_triggered)
+{
+	struct zsock_epoll_event events[2];
+	uint32_t tstamp;
+	ssize_t len;
+	char buf[10];
+	int res;
+
+	setup_socks();
+
+	epoll_add(c_sock, ZSOCK_EPOLLIN);
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	/* Wait for non-ready fd's with timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Wait for non-ready fd's with timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	/* Send pkt for s_sock and wait with timeout of 30 */
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+
+	/* Level triggered, so reported again until the data is read */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	len = zsock_recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	teardown_socks();
+}
+
+ZTEST(net_socket_epoll, test_epoll_edge_triggered_oneshot)
+{
+	struct zsock_epoll_event events[2];
+	struct zsock_epoll_event ev;
+	ssize_t len;
+	char buf[10];
+	int res;
+
+	setup_socks();
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+
+	/* Edge triggered, so not reported again without new data */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	len = zsock_recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	ev.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT;
+	ev.data.fd = s_sock;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+
+	/* One shot, so disabled until re-armed even though data is pending */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+
+	teardown_socks();
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl)
+{
+	struct zsock_epoll_event events[2];
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN,
+	};
+	ssize_t len;
+	int res;
+
+	setup_socks();
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, c_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	/* Removed descriptors are not reported anymore */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	/* Closed descriptors are removed from the interest set */
+	epoll_add(c_sock, ZSOCK_EPOLLOUT);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLOUT, "");
+
+	zassert_ok(zsock_close(c_sock));
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	zassert_ok(zsock_close(epfd));
+	zassert_ok(zsock_close(s_sock));
+}
+
+/* Descriptor which is never ready, and fails to be polled once broken */
+static bool failing_fd_broken;
+
+static int failing_fd_close(void *obj)
+{
+	return 0;
+}
+
+static int failing_fd_ioctl(void *obj, unsigned int request, va_list args)
+{
+	struct zsock_pollfd *pfd;
+
+	if (failing_fd_broken) {
+		return -EIO;
+	}
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE:
+		return -EALREADY;
+	case ZFD_IOCTL_POLL_UPDATE:
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pfd->revents = 0;
+		return 0;
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static const struct fd_op_vtable failing_fd_vtable = {
+	.close = failing_fd_close,
+	.ioctl = failing_fd_ioctl,
+};
+
+static int failing_fd_obj;
+
+ZTEST(net_socket_epoll, test_epoll_poll_error)
+{
+	struct zsock_epoll_event events[2];
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLET,
+	};
+	int fd;
+	int res;
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	fd = zvfs_reserve_fd();
+	zassert_true(fd >= 0, "reserve_fd failed");
+	zvfs_finalize_fd(fd, &failing_fd_obj, &failing_fd_vtable);
+
+	failing_fd_broken = false;
+	epoll_add(fd, ZSOCK_EPOLLIN);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Level triggered, the error is reported on each wait */
+	failing_fd_broken = true;
+
+	for (int i = 0; i < 2; i++) {
+		res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+		zassert_equal(res, 1, "");
+		zassert_equal(events[0].events, ZSOCK_EPOLLERR, "");
+		zassert_equal(events[0].data.fd, fd, "");
+	}
+
+	/* Edge triggered, the error is reported once and the entry is kept */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, fd, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLERR, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, fd, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+
+	zassert_ok(zsock_close(fd));
+	zassert_ok(zsock_close(epfd));
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
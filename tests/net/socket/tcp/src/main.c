@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/buf.h>
 #include <zephyr/net/loopback.h>
 
 #include "../../socket_helpers.h"
@@ -2415,6 +2416,134 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, IS_ENABLED(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC) ?
+			  "cubic" : "reno", "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "unknown",
+			       strlen("unknown"));
+	zassert_equal(ret, -1, "setsockopt should've failed");
+	zassert_equal(errno, ENOENT, "wrong errno value, %d", errno);
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno",
+			       strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				       sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+static void test_recv_zc(int sock, struct zsock_recv_zc_buf *zc)
+{
+	char rx_buf[sizeof(TEST_STR_SMALL)];
+	struct net_buf *frag;
+	size_t offset;
+	size_t len = 0;
+	ssize_t rv;
+
+	rv = zsock_recv_zc(sock, zc, 0, NULL, NULL);
+	zassert_equal(rv, sizeof(TEST_STR_SMALL), "recv_zc failed (%d)", errno);
+
+	for (frag = zc->frags, offset = zc->offset; frag != NULL && len < zc->len;
+	     frag = frag->frags, offset = 0) {
+		size_t frag_len = MIN(frag->len - offset, zc->len - len);
+
+		zassert_true(len + frag_len <= sizeof(rx_buf), "too much data");
+		memcpy(rx_buf + len, frag->data + offset, frag_len);
+		len += frag_len;
+	}
+
+	zassert_equal(len, sizeof(TEST_STR_SMALL), "invalid fragments");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, len, "invalid data");
+}
+
+/* The buffers cannot be lent to user mode threads */
+ZTEST(net_socket_tcp, test_v4_recv_zc)
+{
+	int rv;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct zsock_recv_zc_buf zc;
+	char tx_buf[] = TEST_STR_SMALL;
+	int buf_optval = sizeof(TEST_STR_SMALL);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	/* Window of a single send */
+	rv = zsock_setsockopt(new_sock, SOL_SOCKET, SO_RCVBUF, &buf_optval,
+			      sizeof(buf_optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	test_send(c_sock, tx_buf, sizeof(tx_buf), 0);
+	test_recv_zc(new_sock, &zc);
+
+	/* The window stays closed while the data is held */
+	k_msleep(150);
+
+	rv = zsock_send(c_sock, tx_buf, 1, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "Unexpected return code %d", rv);
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	/* And opens when it is released */
+	zsock_recv_zc_release(&zc);
+	zassert_is_null(zc.frags, "data not released");
+
+	k_msleep(150);
+
+	test_send(c_sock, tx_buf, sizeof(tx_buf), ZSOCK_MSG_DONTWAIT);
+	test_recv_zc(new_sock, &zc);
+
+	/* Data released after the socket was closed is still freed, and the
+	 * context is only released then.
+	 */
+	test_close(new_sock);
+	test_close(c_sock);
+	test_close(s_sock);
+
+	zsock_recv_zc_release(&zc);
+
+	test_context_cleanup();
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
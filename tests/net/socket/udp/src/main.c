@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/ztest_assert.h>
 
 #include <zephyr/net/socket.h>
+#include <zephyr/net/buf.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/net_mgmt.h>
 #include <zephyr/net/net_event.h>
@@ -2528,6 +2529,168 @@ ZTEST(net_socket_udp, test_37_ipv6_src_addr_select)
 				       &my_addr3, &dest);
 }
 
+#define MMSG_COUNT 3
+
+static ZTEST_BMEM char mmsg_rx_bufs[MMSG_COUNT][sizeof(TEST_STR_SMALL)];
+static ZTEST_BMEM struct iovec mmsg_iov[MMSG_COUNT];
+static ZTEST_BMEM struct mmsghdr mmsg_vec[MMSG_COUNT];
+static ZTEST_BMEM struct sockaddr_in mmsg_addrs[MMSG_COUNT];
+
+ZTEST_USER(net_socket_udp, test_38_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock,
+			(struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	rv = zsock_connect(client_sock,
+			   (struct sockaddr *)&server_addr,
+			   sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	/* Each datagram is one byte longer than the previous one */
+	memset(mmsg_vec, 0, sizeof(mmsg_vec));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		mmsg_iov[i].iov_base = TEST_STR_SMALL;
+		mmsg_iov[i].iov_len = STRLEN(TEST_STR_SMALL) - i;
+		mmsg_vec[i].msg_hdr.msg_iov = &mmsg_iov[i];
+		mmsg_vec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, mmsg_vec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(mmsg_vec[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "invalid msg_len %u for message %d",
+			      mmsg_vec[i].msg_len, i);
+	}
+
+	/* Let the loopback deliver all the datagrams */
+	k_msleep(10);
+
+	memset(mmsg_vec, 0, sizeof(mmsg_vec));
+	memset(mmsg_rx_bufs, 0, sizeof(mmsg_rx_bufs));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		mmsg_iov[i].iov_base = mmsg_rx_bufs[i];
+		mmsg_iov[i].iov_len = sizeof(mmsg_rx_bufs[i]);
+		mmsg_vec[i].msg_hdr.msg_iov = &mmsg_iov[i];
+		mmsg_vec[i].msg_hdr.msg_iovlen = 1;
+		mmsg_vec[i].msg_hdr.msg_name = &mmsg_addrs[i];
+		mmsg_vec[i].msg_hdr.msg_namelen = sizeof(mmsg_addrs[i]);
+	}
+
+	rv = zsock_recvmmsg(server_sock, mmsg_vec, MMSG_COUNT, ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(mmsg_vec[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "invalid msg_len %u for message %d",
+			      mmsg_vec[i].msg_len, i);
+		zassert_mem_equal(mmsg_rx_bufs[i], TEST_STR_SMALL,
+				  mmsg_vec[i].msg_len, "invalid data");
+		zassert_equal(mmsg_addrs[i].sin_port, client_addr.sin_port,
+			      "invalid source port");
+	}
+
+	/* Nothing is left, so a non-blocking call must fail right away */
+	rv = zsock_recvmmsg(server_sock, mmsg_vec, MMSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+/* The buffers cannot be lent to user mode threads */
+ZTEST(net_socket_udp, test_39_v4_recv_zc)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	socklen_t addrlen = sizeof(src_addr);
+	struct zsock_recv_zc_buf zc;
+	struct net_buf *frag;
+	char rx_buf[sizeof(TEST_STR_SMALL)];
+	size_t offset;
+	size_t len = 0;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock,
+			(struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	rv = zsock_recv_zc(server_sock, &zc, 0, (struct sockaddr *)&src_addr,
+			   &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recv_zc failed (%d)", errno);
+	zassert_equal(zc.len, STRLEN(TEST_STR_SMALL), "invalid length");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "invalid addrlen");
+	zassert_equal(src_addr.sin_port, client_addr.sin_port,
+		      "invalid source port");
+
+	/* Gather the lent fragments to check the data */
+	for (frag = zc.frags, offset = zc.offset; frag != NULL && len < zc.len;
+	     frag = frag->frags, offset = 0) {
+		size_t frag_len = MIN(frag->len - offset, zc.len - len);
+
+		zassert_true(len + frag_len <= sizeof(rx_buf), "too much data");
+		memcpy(rx_buf + len, frag->data + offset, frag_len);
+		len += frag_len;
+	}
+
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid fragments");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, len, "invalid data");
+
+	zsock_recv_zc_release(&zc);
+	zassert_is_null(zc.frags, "data not released");
+
+	rv = zsock_recv_zc(server_sock, &zc, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(rv, -1, "recv_zc should fail");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_recv_zc(server_sock, &zc, ZSOCK_MSG_PEEK, NULL, NULL);
+	zassert_equal(rv, -1, "recv_zc should fail");
+	zassert_equal(errno, EINVAL, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -20,6 +20,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/linker/sections.h>
 #include <zephyr/tc_util.h>
 
@@ -114,6 +115,7 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_CLIENT_SACK = 19,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +140,7 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_client_sack_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -235,23 +238,23 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
-static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
-					      uint16_t src_port,
-					      uint16_t dst_port,
-					      uint8_t flags,
-					      const uint8_t *data,
-					      size_t len)
+/* Window advertised in the SACK test, large enough for all its segments */
+#define SACK_TEST_WIN 1280U
+
+static struct net_pkt *tester_prepare_tcp_pkt_opts(sa_family_t af,
+						   uint16_t src_port,
+						   uint16_t dst_port,
+						   uint8_t flags,
+						   const uint8_t *opts,
+						   size_t opts_len,
+						   const uint8_t *data,
+						   size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
-	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		opts_len = sizeof(tcp_options);
-	}
-
 	/* Allocate buffer */
 	pkt = net_pkt_alloc_with_buffer(net_iface,
 					sizeof(struct tcphdr) + len + opts_len,
@@ -283,15 +286,15 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
+	th->th_off = 5U + opts_len / 4U;
+	th->th_flags = flags;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
+	if (test_case_no == TEST_CLIENT_SACK) {
+		th->th_win = htons(SACK_TEST_WIN);
 	} else {
-		th->th_off = 5U;
+		th->th_win = NET_IPV6_MTU;
 	}
 
-	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -303,9 +306,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -338,6 +341,23 @@ fail:
 	return NULL;
 }
 
+static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
+					      uint16_t src_port,
+					      uint16_t dst_port,
+					      uint8_t flags,
+					      const uint8_t *data,
+					      size_t len)
+{
+	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		return tester_prepare_tcp_pkt_opts(af, src_port, dst_port, flags,
+						   tcp_options, sizeof(tcp_options),
+						   data, len);
+	}
+
+	return tester_prepare_tcp_pkt_opts(af, src_port, dst_port, flags,
+					   NULL, 0U, data, len);
+}
+
 static struct net_pkt *prepare_syn_packet(sa_family_t af, uint16_t src_port,
 					  uint16_t dst_port)
 {
@@ -490,6 +510,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_CLIENT_SACK:
+		handle_client_sack_test(pkt, &th);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -719,6 +742,15 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+
+		/* MSS option, plus SACK permitted if the peer offered it */
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) {
+			zassert_equal(th->th_off, 7U, "SACK not permitted in SYN ACK");
+		} else {
+			zassert_equal(th->th_off, 6U, "Invalid SYN ACK options");
+		}
+
 		seq++;
 		ack = ntohl(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -2602,4 +2634,255 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+#define SACK_TEST_MSS 100U
+#define SACK_TEST_SEGS 10U
+
+/* MSS of 100 bytes and SACK permitted */
+static const uint8_t sack_test_syn_opts[] = {
+	0x02, 0x04, 0x00, SACK_TEST_MSS,
+	0x01, 0x01, 0x04, 0x02,
+};
+
+static struct {
+	uint32_t seq;
+	uint32_t len;
+} sack_test_sent[2 * SACK_TEST_SEGS];
+
+static atomic_t sack_test_sent_count;
+static uint16_t sack_test_port;
+
+static void handle_client_sack_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	sa_family_t af = net_pkt_family(pkt);
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		device_initial_seq = ntohl(th->th_seq);
+		sack_test_port = th->th_sport;
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = tester_prepare_tcp_pkt_opts(af, htons(MY_PORT), th->th_sport,
+						    SYN | ACK, sack_test_syn_opts,
+						    sizeof(sack_test_syn_opts),
+						    NULL, 0U);
+		seq++;
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		/* Only record the data segments, the test sends the ACKs */
+		len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+		if (len > 0) {
+			atomic_val_t i = atomic_inc(&sack_test_sent_count);
+
+			zassert_true(i < ARRAY_SIZE(sack_test_sent),
+				     "Too many segments sent");
+			sack_test_sent[i].seq = get_rel_seq(th);
+			sack_test_sent[i].len = len;
+		}
+
+		return;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT), th->th_sport);
+		t_state = T_FIN_ACK;
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+#if defined(CONFIG_NET_TCP_SACK) && defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_RENO)
+/* Send an ACK for the relative sequence number rel_ack, carrying the given
+ * SACK blocks (relative start and end pairs), and let the stack process it.
+ */
+static void sack_test_ack(uint32_t rel_ack, const uint32_t *blocks, int count)
+{
+	uint8_t opts[4 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE] = {
+		0x01, 0x01, 0x05, 2 + count * NET_TCP_SACK_BLOCK_SIZE,
+	};
+	struct net_pkt *pkt;
+
+	for (int i = 0; i < 2 * count; i++) {
+		sys_put_be32(device_initial_seq + blocks[i], &opts[4 + i * 4]);
+	}
+
+	ack = device_initial_seq + rel_ack;
+	pkt = tester_prepare_tcp_pkt_opts(AF_INET, htons(MY_PORT), sack_test_port,
+					  ACK, opts,
+					  count ? 4 + count * NET_TCP_SACK_BLOCK_SIZE : 0,
+					  NULL, 0U);
+	zassert_not_null(pkt, "Failed to prepare ACK");
+	zassert_ok(net_recv_data(net_iface, pkt), "Failed to receive ACK");
+
+	k_sleep(K_MSEC(5));
+}
+
+static void sack_test_expect_sent(int count, uint32_t rel_seq, uint32_t len)
+{
+	zassert_equal(atomic_get(&sack_test_sent_count), count,
+		      "Unexpected number of segments, %d vs %d",
+		      (int)atomic_get(&sack_test_sent_count), count);
+	zassert_equal(sack_test_sent[count - 1].seq, rel_seq,
+		      "Unexpected segment sequence number %u vs %u",
+		      sack_test_sent[count - 1].seq, rel_seq);
+	zassert_equal(sack_test_sent[count - 1].len, len,
+		      "Unexpected segment length %u vs %u",
+		      sack_test_sent[count - 1].len, len);
+}
+
+static void sack_test_expect_board(struct tcp *conn, const uint32_t *blocks,
+				   int count)
+{
+	zassert_equal(conn->sack_board_len, count,
+		      "Unexpected number of SACK blocks, %d vs %d",
+		      conn->sack_board_len, count);
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(conn->sack_board[i].start - device_initial_seq,
+			      blocks[2 * i], "Block %d starts at %u", i,
+			      conn->sack_board[i].start - device_initial_seq);
+		zassert_equal(conn->sack_board[i].end - device_initial_seq,
+			      blocks[2 * i + 1], "Block %d ends at %u", i,
+			      conn->sack_board[i].end - device_initial_seq);
+	}
+}
+
+/* Test case scenario IPv4
+ *   expect SYN,
+ *   send SYN ACK with SACK permitted,
+ *   expect ACK,
+ *   expect 10 data segments, of which the 2nd and 4th are lost,
+ *   send duplicate ACKs with SACK blocks, overlapping and adjacent ones,
+ *   expect the 2nd segment to be resent after the 3rd duplicate ACK,
+ *   expect the 4th segment to be held back until the data in flight
+ *   leaves room for it within the window,
+ *   send ACK for all the data,
+ *   expect FIN,
+ *   send FIN ACK,
+ *   expect ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_sack_retransmit)
+{
+	const uint32_t dup1[] = { 201, 301 };
+	const uint32_t dup2[] = { 401, 501, 201, 301 };
+	const uint32_t dup3[] = { 401, 601, 201, 301 };
+	const uint32_t dup4[] = { 401, 701, 201, 301 };
+	const uint32_t dup5[] = { 701, 801, 201, 301 };
+	const uint32_t board3[] = { 201, 301, 401, 601 };
+	const uint32_t board5[] = { 201, 301, 401, 801 };
+	struct net_context *ctx;
+	struct tcp *conn;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_SACK;
+	seq = ack = 0;
+	atomic_clear(&sack_test_sent_count);
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	zassert_ok(net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				       sizeof(struct sockaddr_in), NULL,
+				       K_MSEC(100), NULL),
+		   "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives the ACK */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_true(conn->sack_permitted, "SACK not negotiated");
+
+	/* Send the whole burst at once instead of slow starting */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->ca.cwnd = SACK_TEST_WIN;
+	k_mutex_unlock(&conn->lock);
+
+	ret = net_context_send(ctx, lorem_ipsum, SACK_TEST_MSS * SACK_TEST_SEGS,
+			       NULL, K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer");
+
+	k_sleep(K_MSEC(5));
+
+	for (int i = 0; i < SACK_TEST_SEGS; i++) {
+		zassert_equal(sack_test_sent[i].seq, 1U + i * SACK_TEST_MSS,
+			      "Unexpected segment %d", i);
+	}
+
+	sack_test_expect_sent(SACK_TEST_SEGS, 1U + (SACK_TEST_SEGS - 1) * SACK_TEST_MSS,
+			      SACK_TEST_MSS);
+
+	/* The 2nd (101) and 4th (301) segments are lost */
+	sack_test_ack(101, NULL, 0);
+	sack_test_ack(101, dup1, 1);
+	sack_test_ack(101, dup2, 2);
+
+	/* The 3rd duplicate ACK starts the recovery with a single segment,
+	 * its first block overlaps the known one.
+	 */
+	sack_test_ack(101, dup3, 2);
+	sack_test_expect_board(conn, board3, 2);
+	sack_test_expect_sent(SACK_TEST_SEGS + 1, 101, SACK_TEST_MSS);
+
+	/* The window is half of the 900 outstanding bytes, and 400 bytes are
+	 * still in flight, so the next hole cannot be resent yet.
+	 */
+	sack_test_ack(101, dup4, 2);
+	sack_test_expect_sent(SACK_TEST_SEGS + 1, 101, SACK_TEST_MSS);
+
+	/* An adjacent block, now there is room for the next hole */
+	sack_test_ack(101, dup5, 2);
+	sack_test_expect_board(conn, board5, 2);
+	sack_test_expect_sent(SACK_TEST_SEGS + 2, 301, SACK_TEST_MSS);
+
+	/* All the data is acknowledged, which ends the recovery */
+	sack_test_ack(1U + SACK_TEST_MSS * SACK_TEST_SEGS, NULL, 0);
+	zassert_false(conn->sack_recovery, "Still in recovery");
+	zassert_equal(conn->sack_board_len, 0, "SACK blocks left");
+	zassert_equal(atomic_get(&sack_test_sent_count), SACK_TEST_SEGS + 2,
+		      "Unexpected retransmission");
+
+	t_state = T_FIN;
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#endif /* CONFIG_NET_TCP_SACK && CONFIG_NET_TCP_CONGESTION_DEFAULT_RENO */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
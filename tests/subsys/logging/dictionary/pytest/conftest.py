@@ -8,7 +8,12 @@ import pytest
 
 def pytest_addoption(parser):
     parser.addoption('--fpu', action="store_true")
+    parser.addoption('--fs', action="store_true")
 
 @pytest.fixture()
 def is_fpu_build(request):
     return request.config.getoption('--fpu')
+
+@pytest.fixture()
+def is_fs_build(request):
+    return request.config.getoption('--fs')
@@ -67,16 +67,26 @@ def process_logs(dut: DeviceAdapter, build_dir):
     return decoded_logs
 
 
-def expected_regex_common():
+def expected_regex_printk():
     '''
     Return an array of compiled regular expression for matching
-    the decoded log lines.
+    the decoded printk lines, which only go through the logging
+    backend with CONFIG_LOG_PRINTK.
     '''
     return [
     # *** Booting Zephyr OS build <version> ***
     re.compile(r'.*[*][*][*] Booting Zephyr OS build [0-9a-z.-]+'),
     # Hello World! <board name>
     re.compile(r'[\s]+Hello World! [\w-]+'),
+    ]
+
+
+def expected_regex_common():
+    '''
+    Return an array of compiled regular expression for matching
+    the decoded log lines.
+    '''
+    return [
     # [        10] <err> hello_world: error string
     re.compile(r'[\s]+[\[][0-9,:\. ]+[\]] <err> hello_world: error string'),
     # [        10] <dbg> hello_world: main: debug string
@@ -150,16 +160,20 @@ def regex_matching(decoded_logs, expected_regex):
     return all(regex_results)
 
 
-def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build):
+def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build, is_fs_build):
     '''
     Main entrance to setup test result validation.
     '''
     build_dir = dut.device_config.app_build_dir
 
     logger.info(f'FPU build? {is_fpu_build}')
+    logger.info(f'File system build? {is_fs_build}')
 
     decoded_logs = process_logs(dut, build_dir)
 
+    if not is_fs_build:
+        assert regex_matching(decoded_logs, expected_regex_printk())
+
     assert regex_matching(decoded_logs, expected_regex_common())
 
     if is_fpu_build:
@@ -13,10 +13,83 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/shell/shell.h>
 
+#ifdef CONFIG_LOG_BACKEND_FS
+#include <limits.h>
+#include <stdlib.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend_fs.h>
+#endif
+
 LOG_MODULE_REGISTER(hello_world, LOG_LEVEL_DBG);
 
 static const char *hexdump_msg = "HEXDUMP! HEXDUMP@ HEXDUMP#";
 
+#ifdef CONFIG_LOG_BACKEND_FS
+/*
+ * Print the log files written by the file system backend, oldest first,
+ * in the hexadecimal form of the UART backend so that the pytest harness
+ * decodes them the same way.
+ */
+static void dump_log_files(void)
+{
+	const size_t prefix_len = strlen(CONFIG_LOG_BACKEND_FS_FILE_PREFIX);
+	static struct fs_dirent entry;
+	struct fs_file_t file;
+	struct fs_dir_t dir;
+	char fname[64];
+	uint8_t buf[32];
+	int first = INT_MAX;
+	int last = -1;
+	ssize_t len;
+
+	while (log_process()) {
+	}
+
+	(void)log_backend_fs_flush();
+
+	fs_dir_t_init(&dir);
+	if (fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR) != 0) {
+		printk("Cannot open %s\n", CONFIG_LOG_BACKEND_FS_DIR);
+		return;
+	}
+
+	while ((fs_readdir(&dir, &entry) == 0) && (entry.name[0] != '\0')) {
+		if (strncmp(entry.name, CONFIG_LOG_BACKEND_FS_FILE_PREFIX,
+			    prefix_len) == 0) {
+			int num = atoi(&entry.name[prefix_len]);
+
+			first = MIN(first, num);
+			last = MAX(last, num);
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+	printk("##ZLOGV1##");
+
+	for (int i = first; i <= last; i++) {
+		snprintk(fname, sizeof(fname), "%s/%s%04d", CONFIG_LOG_BACKEND_FS_DIR,
+			 CONFIG_LOG_BACKEND_FS_FILE_PREFIX, i);
+
+		fs_file_t_init(&file);
+		if (fs_open(&file, fname, FS_O_READ) != 0) {
+			continue;
+		}
+
+		while ((len = fs_read(&file, buf, sizeof(buf))) > 0) {
+			for (ssize_t j = 0; j < len; j++) {
+				printk("%02x", buf[j]);
+			}
+		}
+
+		(void)fs_close(&file);
+	}
+
+	printk("\r\n");
+}
+#endif
+
 int main(void)
 {
 	int8_t i8 = 1;
@@ -73,6 +146,10 @@ int main(void)
 #endif
 #endif
 
+#ifdef CONFIG_LOG_BACKEND_FS
+	dump_log_files();
+#endif
+
 #if defined(CONFIG_STDOUT_CONSOLE)
 	/*
 	 * When running through twister with pytest, we need to add a newline
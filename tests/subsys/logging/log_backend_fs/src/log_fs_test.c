@@ -15,6 +15,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/logging/log_backend_fs.h>
 
 #define DT_DRV_COMPAT zephyr_fstab_littlefs
 #define TEST_AUTOMOUNT DT_PROP(DT_DRV_INST(0), automount)
@@ -30,6 +31,17 @@ static const char *log_prefix = CONFIG_LOG_BACKEND_FS_FILE_PREFIX;
 
 int write_log_to_file(uint8_t *data, size_t length, void *ctx);
 
+/* With buffered writes, flush so that the files can be checked at once. */
+static int write_log(uint8_t *data, size_t length)
+{
+	int rc = write_log_to_file(data, length, NULL);
+
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+	(void)log_backend_fs_flush();
+#endif
+
+	return rc;
+}
 
 ZTEST(test_log_backend_fs, test_fs_nonexist)
 {
@@ -39,7 +51,7 @@ ZTEST(test_log_backend_fs, test_fs_nonexist)
 	uint8_t to_log[] = "Log to left behind";
 	int rc;
 
-	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	rc = write_log(to_log, sizeof(to_log));
 	zassert_equal(rc, sizeof(to_log), "Unexpected rteval.");
 	struct fs_mount_t *mp = &FS_FSTAB_ENTRY(PARTITION_NODE);
 
@@ -96,7 +108,7 @@ ZTEST(test_log_backend_fs, test_log_fs_file_content)
 
 	fs_file_t_init(&file);
 
-	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	rc = write_log(to_log, sizeof(to_log));
 
 	sprintf(fname, "%s/%s0000", CONFIG_LOG_BACKEND_FS_DIR, log_prefix);
 
@@ -112,7 +124,7 @@ ZTEST(test_log_backend_fs, test_log_fs_file_content)
 	zassert_equal(fs_close(&file), 0, "Can not close log file.");
 
 	to_log[sizeof(to_log)-2] = '2';
-	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	rc = write_log(to_log, sizeof(to_log));
 
 	zassert_equal(fs_open(&file, fname, FS_O_READ), 0,
 		      "Can not open log file.");
@@ -149,7 +161,7 @@ ZTEST(test_log_backend_fs, test_log_fs_file_size)
 	     i <= (CONFIG_LOG_BACKEND_FS_FILE_SIZE - entry.size) /
 		  sizeof(to_log);
 	     i++) {
-		rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+		rc = write_log(to_log, sizeof(to_log));
 		/* Written length not tracked here. */
 		ARG_UNUSED(rc);
 	}
@@ -203,7 +215,7 @@ ZTEST(test_log_backend_fs, test_log_fs_files_max)
 	     i <= CONFIG_LOG_BACKEND_FS_FILE_SIZE /
 		  sizeof(to_log) * (CONFIG_LOG_BACKEND_FS_FILES_LIMIT - 1);
 	     i++) {
-		rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+		rc = write_log(to_log, sizeof(to_log));
 		/* Written length not tracked here. */
 		ARG_UNUSED(rc);
 	}
@@ -230,4 +242,76 @@ ZTEST(test_log_backend_fs, test_log_fs_files_max)
 	zassert_equal(test_mask, 0b11110, "Unexpected file numeration");
 }
 
+#ifdef CONFIG_LOG_BACKEND_FS_BUFFERED
+/* Returns the number of the newest log file and its size */
+static int newest_log_file(size_t *size)
+{
+	struct fs_dir_t dir;
+	struct fs_dirent ent;
+	int newest = -1;
+	int rc;
+
+	fs_dir_t_init(&dir);
+
+	rc = fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR);
+	zassert_equal(rc, 0, "Can not open directory.");
+
+	while (true) {
+		rc = fs_readdir(&dir, &ent);
+		if ((rc < 0) || (ent.name[0] == 0)) {
+			break;
+		}
+		if (strstr(ent.name, log_prefix) != NULL &&
+		    atoi(&ent.name[strlen(log_prefix)]) > newest) {
+			newest = atoi(&ent.name[strlen(log_prefix)]);
+			*size = ent.size;
+		}
+	}
+	(void)fs_closedir(&dir);
+
+	return newest;
+}
+#endif
+
+ZTEST(test_log_backend_fs, test_log_fs_write_buffered)
+{
+#ifndef CONFIG_LOG_BACKEND_FS_BUFFERED
+	ztest_test_skip();
+#else
+	uint8_t to_log[] = "Buffered Log";
+	char log_read[sizeof(to_log)];
+	static char fname[MAX_PATH_LEN];
+	struct fs_file_t file;
+	size_t size, new_size;
+	int newest;
+	int rc;
+
+	fs_file_t_init(&file);
+	newest = newest_log_file(&size);
+
+	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	zassert_equal(rc, sizeof(to_log), "Unexpected rteval.");
+
+	/* Nothing written before the flush */
+	zassert_equal(newest_log_file(&new_size), newest, "Unexpected new file");
+	zassert_equal(new_size, size, "Unexpected write");
+
+	zassert_equal(log_backend_fs_flush(), 0, "Can not flush.");
+
+	newest = newest_log_file(&size);
+	zassert_true(size >= sizeof(to_log), "Log not flushed");
+
+	sprintf(fname, "%s/%s%04d", CONFIG_LOG_BACKEND_FS_DIR, log_prefix, newest);
+	zassert_equal(fs_open(&file, fname, FS_O_READ), 0,
+		      "Can not open log file.");
+	zassert_equal(fs_seek(&file, size - sizeof(to_log), FS_SEEK_SET), 0,
+		      "Bad file size");
+	zassert_equal(fs_read(&file, log_read, sizeof(log_read)), sizeof(log_read),
+		      "Can not read log file.");
+	zassert_mem_equal(log_read, to_log, sizeof(to_log),
+			  "Text inside log file is not correct.");
+	zassert_equal(fs_close(&file), 0, "Can not close log file.");
+#endif
+}
+
 ZTEST_SUITE(test_log_backend_fs, NULL, NULL, NULL, NULL, NULL);
@@ -619,3 +619,54 @@ ZTEST(settings_functional, test_direct_loading_filter)
 	}
 	settings_deregister(&filtered_loader_settings);
 }
+
+SETTINGS_STATIC_HANDLER_DEFINE(lookup, "lookup", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_a, "lookup/a", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_a_b, "lookup/a/b", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lookup_ab, "lookup/ab", NULL, NULL, NULL, NULL);
+
+ZTEST(settings_functional, test_static_lookup)
+{
+	static const struct {
+		const char *name;
+		const char *handler;
+		const char *next;
+	} lookups[] = {
+		{ "lookup", "lookup", NULL },
+		{ "lookup=1", "lookup", NULL },
+		{ "lookup/c", "lookup", "c" },
+		{ "lookup/a", "lookup/a", NULL },
+		{ "lookup/a/", "lookup/a", "" },
+		{ "lookup/a/c/d", "lookup/a", "c/d" },
+		{ "lookup/a/b/c=1", "lookup/a/b", "c=1" },
+		{ "lookup/ab", "lookup/ab", NULL },
+		{ "lookup/abc", "lookup", "abc" },
+		{ "lookupa/b", NULL, NULL },
+		{ "look", NULL, NULL },
+	};
+	struct settings_handler_static *ch;
+	const char *next;
+
+	settings_subsys_init();
+
+	for (int i = 0; i < ARRAY_SIZE(lookups); i++) {
+		ch = settings_parse_and_lookup(lookups[i].name, &next);
+
+		if (lookups[i].handler == NULL) {
+			zassert_is_null(ch, "%s has a handler", lookups[i].name);
+			continue;
+		}
+
+		zassert_not_null(ch, "%s has no handler", lookups[i].name);
+		zassert_str_equal(ch->name, lookups[i].handler,
+				  "%s has handler %s", lookups[i].name, ch->name);
+
+		if (lookups[i].next == NULL) {
+			zassert_is_null(next, "%s has next %s", lookups[i].name, next);
+		} else {
+			zassert_not_null(next, "%s has no next", lookups[i].name);
+			zassert_str_equal(next, lookups[i].next,
+					  "%s has next %s", lookups[i].name, next);
+		}
+	}
+}